@@ -55,4 +55,409 @@ int main() {
     account.withdraw(3000);
     account.showBalance();
     return 0;
-}
\ No newline at end of file
+}
+
+
+
+// Thread-Safe BankAccount with Atomic Compare-And-Swap (C++)
+
+#include <iostream>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <chrono>
+using namespace std;
+
+// PROBLEM:
+// In the class above, withdraw() first CHECKS (amount <= balance) and then
+// SUBTRACTS. If two threads do this at the same time, both can pass the check
+// before either subtracts, and the account goes below zero.
+
+// SOLUTION:
+// Keep the balance in an atomic<int> and use compare_exchange (CAS).
+// CAS says: "change the balance from 'current' to 'current - amount',
+// but ONLY if nobody changed it in the meantime". If somebody did, we
+// re-read the new value and check the rule again.
+class ConcurrentBankAccount {
+private:
+    atomic<int> balance;
+
+public:
+    explicit ConcurrentBankAccount(int initial) : balance(initial) {}
+
+    bool deposit(int amount) {
+        if (amount <= 0) {
+            return false;
+        }
+        balance.fetch_add(amount, memory_order_relaxed);
+        return true;
+    }
+
+    bool withdraw(int amount) {
+        if (amount <= 0) {
+            return false;
+        }
+        int current = balance.load(memory_order_relaxed);
+        while (amount <= current) {          // guard is re-checked on every retry
+            // On failure, 'current' is refreshed with the latest balance.
+            if (balance.compare_exchange_weak(current, current - amount,
+                                              memory_order_acq_rel,
+                                              memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;                        // not enough money: nothing changed
+    }
+
+    int getBalance() const {
+        return balance.load(memory_order_acquire);
+    }
+};
+
+// BASELINE: the same rules protected by a mutex (one lock per account).
+class MutexBankAccount {
+private:
+    int balance;
+    mutable mutex lock;
+
+public:
+    explicit MutexBankAccount(int initial) : balance(initial) {}
+
+    bool deposit(int amount) {
+        if (amount <= 0) {
+            return false;
+        }
+        lock_guard<mutex> guard(lock);
+        balance += amount;
+        return true;
+    }
+
+    bool withdraw(int amount) {
+        if (amount <= 0) {
+            return false;
+        }
+        lock_guard<mutex> guard(lock);
+        if (amount <= balance) {
+            balance -= amount;
+            return true;
+        }
+        return false;
+    }
+
+    int getBalance() const {
+        lock_guard<mutex> guard(lock);
+        return balance;
+    }
+};
+
+// Every thread hammers the SAME account with deposits and withdrawals.
+// Returns the number of successful withdrawals so we can check the final balance.
+template <typename Account>
+long long runWorkers(Account& account, int threads, int opsPerThread) {
+    atomic<long long> withdrawn(0);
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&account, &withdrawn, opsPerThread]() {
+            long long mine = 0;
+            for (int i = 0; i < opsPerThread; i++) {
+                if (i % 2 == 0) {
+                    account.deposit(10);
+                } else if (account.withdraw(15)) {
+                    mine += 15;
+                }
+            }
+            withdrawn += mine;
+        });
+    }
+    for (thread& w : workers) {
+        w.join();
+    }
+    return withdrawn;
+}
+
+template <typename Account>
+double opsPerSecond(int threads, int opsPerThread) {
+    Account account(0);
+    auto start = chrono::steady_clock::now();
+    runWorkers(account, threads, opsPerThread);
+    chrono::duration<double> seconds = chrono::steady_clock::now() - start;
+    return threads * (double)opsPerThread / seconds.count();
+}
+
+int main() {
+    // ---------------------------------------------------------
+    // STRESS TEST: the balance can never go below zero
+    // ---------------------------------------------------------
+    const int threads = 8;
+    const int ops = 200000;
+
+    ConcurrentBankAccount account(1000);
+    long long withdrawn = runWorkers(account, threads, ops);
+    long long deposited = (long long)threads * (ops / 2) * 10;
+    long long expected = 1000 + deposited - withdrawn;
+
+    cout << "--- Stress Test (" << threads << " threads) ---" << endl;
+    cout << "Final balance:    " << account.getBalance() << endl;
+    cout << "Expected balance: " << expected << endl;
+    cout << (account.getBalance() == expected && account.getBalance() >= 0
+                 ? "PASS: no lost updates, never overdrawn"
+                 : "FAIL: balance is inconsistent") << endl;
+
+    // ---------------------------------------------------------
+    // BENCHMARK: ops/sec from 1 to N threads
+    // ---------------------------------------------------------
+    int maxThreads = (int)thread::hardware_concurrency();
+    if (maxThreads < 4) {
+        maxThreads = 4;
+    }
+
+    cout << "\n--- Benchmark (ops/sec) ---" << endl;
+    cout << "threads\tatomic CAS\tmutex" << endl;
+    for (int t = 1; t <= maxThreads; t *= 2) {
+        cout << t << "\t"
+             << (long long)opsPerSecond<ConcurrentBankAccount>(t, ops) << "\t"
+             << (long long)opsPerSecond<MutexBankAccount>(t, ops) << endl;
+    }
+
+    return 0;
+}
+
+
+
+// Scaling Up – A Sharded Store of Millions of BankAccounts (C++)
+
+#include <iostream>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <string>
+using namespace std;
+
+// The same guarded class as above, with results reported as bool
+// instead of printed. Balances are 64-bit: the store holds 10 billion in
+// total, so one popular account could overflow an int.
+class BankAccount {
+private:
+    int64_t balance;
+
+public:
+    explicit BankAccount(int64_t initial) : balance(initial) {}
+
+    bool deposit(int64_t amount) {
+        if (amount <= 0) {
+            return false;
+        }
+        balance += amount;
+        return true;
+    }
+
+    bool withdraw(int64_t amount) {
+        if (amount <= 0 || amount > balance) {
+            return false;
+        }
+        balance -= amount;
+        return true;
+    }
+
+    int64_t getBalance() const {
+        return balance;
+    }
+};
+
+// IDEA:
+// One big lock around ALL accounts would let only one thread work at a time.
+// One lock per account would cost a mutex for each of millions of accounts.
+// A SHARDED store is in between: accounts are split into N groups (shards),
+// each with its own lock. Account 'id' lives in shard (id % N) at position (id / N).
+class AccountStore {
+private:
+    // alignas(64): every shard starts on its own CPU cache line, so two
+    // threads locking NEIGHBOURING shards do not slow each other down.
+    struct alignas(64) Shard {
+        mutex lock;
+        vector<BankAccount> accounts;
+    };
+
+    vector<Shard> shards;
+    uint32_t count;
+
+    Shard& shardOf(uint32_t id) {
+        return shards[id % shards.size()];
+    }
+
+    BankAccount& accountIn(Shard& shard, uint32_t id) {
+        return shard.accounts[id / shards.size()];
+    }
+
+public:
+    AccountStore(uint32_t accountCount, int64_t initialBalance, size_t shardCount = 256)
+        : shards(shardCount), count(accountCount) {
+        for (size_t s = 0; s < shardCount; s++) {
+            uint32_t inShard = accountCount / shardCount + (s < accountCount % shardCount ? 1 : 0);
+            shards[s].accounts.assign(inShard, BankAccount(initialBalance));
+        }
+    }
+
+    bool exists(uint32_t id) const {
+        return id < count;
+    }
+
+    bool deposit(uint32_t id, int64_t amount) {
+        if (!exists(id)) {
+            return false;
+        }
+        Shard& shard = shardOf(id);
+        lock_guard<mutex> guard(shard.lock);
+        return accountIn(shard, id).deposit(amount);
+    }
+
+    // An unknown id is rejected like in transfer(), so it can never be
+    // mistaken for an empty account.
+    bool getBalance(uint32_t id, int64_t& balance) {
+        if (!exists(id)) {
+            return false;
+        }
+        Shard& shard = shardOf(id);
+        lock_guard<mutex> guard(shard.lock);
+        balance = accountIn(shard, id).getBalance();
+        return true;
+    }
+
+    // ATOMIC TRANSFER: nobody can ever see the money "in the middle"
+    // (taken from 'from' but not yet added to 'to').
+    //
+    // DEADLOCK RULE: when two shards are needed, ALWAYS lock the one with the
+    // smaller index first. Thread A (x -> y) and thread B (y -> x) then try to
+    // take the same lock first, so they can never wait on each other forever.
+    bool transfer(uint32_t from, uint32_t to, int64_t amount) {
+        if (from == to || amount <= 0 || !exists(from) || !exists(to)) {
+            return false;
+        }
+        size_t a = from % shards.size();
+        size_t b = to % shards.size();
+
+        unique_lock<mutex> first(shards[a < b ? a : b].lock);
+        unique_lock<mutex> second;
+        if (a != b) {
+            second = unique_lock<mutex>(shards[a < b ? b : a].lock);
+        }
+
+        if (!accountIn(shards[a], from).withdraw(amount)) {
+            return false;
+        }
+        accountIn(shards[b], to).deposit(amount);
+        return true;
+    }
+
+    int64_t totalMoney() {
+        int64_t total = 0;
+        for (Shard& shard : shards) {
+            lock_guard<mutex> guard(shard.lock);
+            for (const BankAccount& account : shard.accounts) {
+                total += account.getBalance();
+            }
+        }
+        return total;
+    }
+};
+
+// Zipf-distributed account ids (a few accounts are VERY popular),
+// using the generator from Gray et al., "Quickly Generating Billion-Record
+// Synthetic Databases" (the same one the YCSB benchmark uses).
+class ZipfGenerator {
+private:
+    uint32_t n;
+    double theta, alpha, zetan, eta;
+
+public:
+    ZipfGenerator(uint32_t count, double skew) : n(count), theta(skew) {
+        double zeta2 = 1.0 + pow(0.5, theta);
+        zetan = 0;
+        for (uint32_t i = 1; i <= n; i++) {
+            zetan += 1.0 / pow(i, theta);
+        }
+        alpha = 1.0 / (1.0 - theta);
+        eta = (1.0 - pow(2.0 / n, 1.0 - theta)) / (1.0 - zeta2 / zetan);
+    }
+
+    uint32_t next(double u) const {       // u is uniform in [0, 1)
+        double uz = u * zetan;
+        if (uz < 1.0) return 0;
+        if (uz < 1.0 + pow(0.5, theta)) return 1;
+        uint32_t rank = (uint32_t)(n * pow(eta * u - eta + 1.0, alpha));
+        return rank < n ? rank : n - 1;
+    }
+};
+
+double transfersPerSecond(AccountStore& store, uint32_t accounts, int threads,
+                          const ZipfGenerator* zipf) {
+    const int transfersPerThread = 500000;
+    vector<thread> workers;
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&store, accounts, zipf, t]() {
+            mt19937 rng(1234 + t);
+            uniform_int_distribution<uint32_t> uniform(0, accounts - 1);
+            uniform_real_distribution<double> unit(0.0, 1.0);
+            for (int i = 0; i < transfersPerThread; i++) {
+                uint32_t from = zipf ? zipf->next(unit(rng)) : uniform(rng);
+                uint32_t to = zipf ? zipf->next(unit(rng)) : uniform(rng);
+                store.transfer(from, to, 1 + (int)(rng() % 50));
+            }
+        });
+    }
+    for (thread& w : workers) {
+        w.join();
+    }
+    chrono::duration<double> seconds = chrono::steady_clock::now() - start;
+    return threads * (double)transfersPerThread / seconds.count();
+}
+
+int main() {
+    const uint32_t accounts = 10000000;    // ten million accounts
+    const int64_t initialBalance = 1000;
+
+    AccountStore store(accounts, initialBalance);
+    int64_t before = store.totalMoney();
+
+    store.transfer(42, 9999999, 250);
+    int64_t balance;
+    if (store.getBalance(42, balance)) {
+        cout << "Account 42:      " << balance << endl;
+    }
+    if (store.getBalance(9999999, balance)) {
+        cout << "Account 9999999: " << balance << endl;
+    }
+    cout << "Balance of unknown account 10000000: "
+         << (store.getBalance(10000000, balance) ? to_string(balance) : "rejected") << endl;
+    cout << "Transfer to unknown account 10000000: "
+         << (store.transfer(42, 10000000, 250) ? "done" : "rejected") << endl;
+
+    // ---------------------------------------------------------
+    // BENCHMARK: transfers/sec, uniform vs. Zipf-skewed access
+    // ---------------------------------------------------------
+    ZipfGenerator zipf(accounts, 0.99);
+    int maxThreads = (int)thread::hardware_concurrency();
+    if (maxThreads < 4) {
+        maxThreads = 4;
+    }
+
+    cout << "\n--- Transfer Benchmark (" << accounts << " accounts) ---" << endl;
+    cout << "threads\tuniform\t\tzipf(0.99)" << endl;
+    for (int t = 1; t <= maxThreads; t *= 2) {
+        cout << t << "\t" << (long long)transfersPerSecond(store, accounts, t, nullptr)
+             << "\t" << (long long)transfersPerSecond(store, accounts, t, &zipf) << endl;
+    }
+
+    // Money is only MOVED, never created or lost.
+    cout << "\nTotal money before: " << before << endl;
+    cout << "Total money after:  " << store.totalMoney() << endl;
+
+    return 0;
+}
@@ -23,4 +23,307 @@ int main() {
     cout << "Roll No: " << student1.rollNo << "\n";
     cout << "CGPA: " << student1.cgpa << endl;
     return 0;
-}
\ No newline at end of file
+}
+
+
+// Many Objects: Array of Structs vs. Columns (StudentTable)
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+class Student {
+public:
+    int rollNo;
+    float cgpa;
+};
+
+// A column: one field of EVERY student stored back-to-back,
+// starting on a 64-byte boundary (one CPU cache line).
+template <typename T>
+class AlignedColumn {
+private:
+    T* data;
+    size_t count;
+    size_t capacity;
+
+public:
+    AlignedColumn() : data(nullptr), count(0), capacity(0) {}
+
+    ~AlignedColumn() {
+        free(data);
+    }
+
+    AlignedColumn(const AlignedColumn&) = delete;
+    AlignedColumn& operator=(const AlignedColumn&) = delete;
+
+    void push_back(T value) {
+        if (count == capacity) {
+            reserve(capacity ? capacity * 2 : 64);
+        }
+        data[count++] = value;
+    }
+
+    void reserve(size_t n) {
+        if (n <= capacity) {
+            return;
+        }
+        // aligned_alloc needs the size to be a multiple of the alignment
+        size_t bytes = (n * sizeof(T) + 63) / 64 * 64;
+        T* bigger = (T*)aligned_alloc(64, bytes);
+        if (!bigger) {
+            throw bad_alloc();
+        }
+        for (size_t i = 0; i < count; i++) {
+            bigger[i] = data[i];
+        }
+        free(data);
+        data = bigger;
+        capacity = bytes / sizeof(T);
+    }
+
+    size_t size() const { return count; }
+    const T* begin() const { return data; }
+    T operator[](size_t i) const { return data[i]; }
+};
+
+// STRUCTURE OF ARRAYS
+// vector<Student> stores  [roll, cgpa][roll, cgpa][roll, cgpa]...
+// StudentTable stores     [roll, roll, roll, ...]  and  [cgpa, cgpa, cgpa, ...]
+// A CGPA query then reads ONLY the cgpa column: half the memory traffic,
+// and 4 (SSE) or 8 (AVX2) values can be processed per instruction.
+class StudentTable {
+private:
+    AlignedColumn<int> rollNos;
+    AlignedColumn<float> cgpas;
+
+public:
+    void reserve(size_t n) {
+        rollNos.reserve(n);
+        cgpas.reserve(n);
+    }
+
+    void add(int rollNo, float cgpa) {
+        rollNos.push_back(rollNo);
+        cgpas.push_back(cgpa);
+    }
+
+    size_t size() const {
+        return cgpas.size();
+    }
+
+    Student get(size_t i) const {
+        return Student{rollNos[i], cgpas[i]};
+    }
+
+    double averageCgpa() const;
+    size_t countAbove(float threshold) const;
+    float minCgpa() const;
+    float maxCgpa() const;
+};
+
+double StudentTable::averageCgpa() const {
+    const float* c = cgpas.begin();
+    size_t n = size(), i = 0;
+    double sum = 0;
+    // Floats are added in small blocks, and every block total goes into a
+    // double, so millions of values do not lose precision.
+#if defined(__AVX2__)
+    const size_t block = 1024;
+    for (; i + block <= n; i += block) {
+        __m256 acc = _mm256_setzero_ps();
+        for (size_t k = i; k < i + block; k += 8) {
+            acc = _mm256_add_ps(acc, _mm256_load_ps(c + k));
+        }
+        float lanes[8];
+        _mm256_storeu_ps(lanes, acc);
+        for (float v : lanes) sum += v;
+    }
+#elif defined(__SSE2__)
+    const size_t block = 1024;
+    for (; i + block <= n; i += block) {
+        __m128 acc = _mm_setzero_ps();
+        for (size_t k = i; k < i + block; k += 4) {
+            acc = _mm_add_ps(acc, _mm_load_ps(c + k));
+        }
+        float lanes[4];
+        _mm_storeu_ps(lanes, acc);
+        for (float v : lanes) sum += v;
+    }
+#endif
+    for (; i < n; i++) {                         // scalar tail / fallback
+        sum += c[i];
+    }
+    return n ? sum / n : 0.0;
+}
+
+size_t StudentTable::countAbove(float threshold) const {
+    const float* c = cgpas.begin();
+    size_t n = size(), i = 0, count = 0;
+#if defined(__AVX2__)
+    const __m256 t = _mm256_set1_ps(threshold);
+    for (; i + 8 <= n; i += 8) {
+        __m256 above = _mm256_cmp_ps(_mm256_load_ps(c + i), t, _CMP_GT_OQ);
+        count += __builtin_popcount(_mm256_movemask_ps(above));
+    }
+#elif defined(__SSE2__)
+    const __m128 t = _mm_set1_ps(threshold);
+    for (; i + 4 <= n; i += 4) {
+        __m128 above = _mm_cmpgt_ps(_mm_load_ps(c + i), t);
+        count += __builtin_popcount(_mm_movemask_ps(above));
+    }
+#endif
+    for (; i < n; i++) {
+        count += c[i] > threshold;
+    }
+    return count;
+}
+
+float StudentTable::minCgpa() const {
+    const float* c = cgpas.begin();
+    size_t n = size(), i = 0;
+    float best = n ? c[0] : 0.0f;
+#if defined(__AVX2__)
+    if (n >= 8) {
+        __m256 m = _mm256_load_ps(c);
+        for (i = 8; i + 8 <= n; i += 8) {
+            m = _mm256_min_ps(m, _mm256_load_ps(c + i));
+        }
+        float lanes[8];
+        _mm256_storeu_ps(lanes, m);
+        for (float v : lanes) best = v < best ? v : best;
+    }
+#elif defined(__SSE2__)
+    if (n >= 4) {
+        __m128 m = _mm_load_ps(c);
+        for (i = 4; i + 4 <= n; i += 4) {
+            m = _mm_min_ps(m, _mm_load_ps(c + i));
+        }
+        float lanes[4];
+        _mm_storeu_ps(lanes, m);
+        for (float v : lanes) best = v < best ? v : best;
+    }
+#endif
+    for (; i < n; i++) {
+        best = c[i] < best ? c[i] : best;
+    }
+    return best;
+}
+
+float StudentTable::maxCgpa() const {
+    const float* c = cgpas.begin();
+    size_t n = size(), i = 0;
+    float best = n ? c[0] : 0.0f;
+#if defined(__AVX2__)
+    if (n >= 8) {
+        __m256 m = _mm256_load_ps(c);
+        for (i = 8; i + 8 <= n; i += 8) {
+            m = _mm256_max_ps(m, _mm256_load_ps(c + i));
+        }
+        float lanes[8];
+        _mm256_storeu_ps(lanes, m);
+        for (float v : lanes) best = v > best ? v : best;
+    }
+#elif defined(__SSE2__)
+    if (n >= 4) {
+        __m128 m = _mm_load_ps(c);
+        for (i = 4; i + 4 <= n; i += 4) {
+            m = _mm_max_ps(m, _mm_load_ps(c + i));
+        }
+        float lanes[4];
+        _mm_storeu_ps(lanes, m);
+        for (float v : lanes) best = v > best ? v : best;
+    }
+#endif
+    for (; i < n; i++) {
+        best = c[i] > best ? c[i] : best;
+    }
+    return best;
+}
+
+int main() {
+    const size_t students = 5000000;
+    const float threshold = 3.5f;
+
+    // The SAME data in both layouts
+    vector<Student> list;
+    list.reserve(students);
+    StudentTable table;
+    table.reserve(students);
+
+    mt19937 rng(7);
+    uniform_real_distribution<float> pickCgpa(1.0f, 4.0f);
+    for (size_t i = 0; i < students; i++) {
+        Student s;
+        s.rollNo = 100 + (int)i;
+        s.cgpa = pickCgpa(rng);
+        list.push_back(s);
+        table.add(s.rollNo, s.cgpa);
+    }
+
+    // ---------------------------------------------------------
+    // Each query is timed on both layouts:
+    //   vector<Student>  -> a normal loop over the objects
+    //   StudentTable     -> the column kernels above
+    // ---------------------------------------------------------
+    double sum = 0;
+    size_t above = 0;
+    float lo = list[0].cgpa, hi = list[0].cgpa;
+    double avg = 0;
+    size_t tableAbove = 0;
+    float tableLo = 0, tableHi = 0;
+    chrono::duration<double, milli> aos[4], soa[4];
+
+    auto start = chrono::steady_clock::now();
+    for (const Student& s : list) sum += s.cgpa;
+    aos[0] = chrono::steady_clock::now() - start;
+    start = chrono::steady_clock::now();
+    avg = table.averageCgpa();
+    soa[0] = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    for (const Student& s : list) above += s.cgpa > threshold;
+    aos[1] = chrono::steady_clock::now() - start;
+    start = chrono::steady_clock::now();
+    tableAbove = table.countAbove(threshold);
+    soa[1] = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    for (const Student& s : list) lo = s.cgpa < lo ? s.cgpa : lo;
+    aos[2] = chrono::steady_clock::now() - start;
+    start = chrono::steady_clock::now();
+    tableLo = table.minCgpa();
+    soa[2] = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    for (const Student& s : list) hi = s.cgpa > hi ? s.cgpa : hi;
+    aos[3] = chrono::steady_clock::now() - start;
+    start = chrono::steady_clock::now();
+    tableHi = table.maxCgpa();
+    soa[3] = chrono::steady_clock::now() - start;
+
+    cout << "Students:         " << students << endl;
+    cout << "Average CGPA:     " << avg << "  (vector: " << sum / students << ")" << endl;
+    cout << "CGPA > " << threshold << ":       " << tableAbove << "  (vector: " << above << ")" << endl;
+    cout << "Min / Max CGPA:   " << tableLo << " / " << tableHi
+         << "  (vector: " << lo << " / " << hi << ")" << endl;
+
+    const char* names[4] = {"average ", "count > ", "min     ", "max     "};
+    cout << "\n--- Benchmark (ms) ---" << endl;
+    cout << "query\t\tvector<Student>\tStudentTable" << endl;
+    for (int q = 0; q < 4; q++) {
+        cout << names[q] << "\t" << aos[q].count() << "\t\t" << soa[q].count() << endl;
+    }
+
+    return 0;
+}
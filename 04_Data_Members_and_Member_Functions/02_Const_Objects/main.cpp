@@ -91,3 +91,181 @@ int main() {
 
     return 0;
 }
+
+//-----------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <chrono>
+using namespace std;
+
+// A consistent "picture" of the account, returned by the const reader.
+struct AccountSnapshot {
+    double balance;
+    double totalDeposited;
+    double totalWithdrawn;
+};
+
+class BankAccount {
+private:
+    // SEQUENCE LOCK (seqlock)
+    // 'version' is EVEN while the data is stable and ODD while a writer is
+    // in the middle of an update. Readers never lock: they read the fields,
+    // and if the version changed (or was odd) they simply read again.
+    atomic<unsigned> version;
+
+    atomic<double> balance;
+    atomic<double> totalDeposited;
+    atomic<double> totalWithdrawn;
+
+    mutex writerLock;   // only WRITERS use this, to take turns with each other
+
+    void beginWrite() {
+        unsigned v = version.load(memory_order_relaxed);
+        version.store(v + 1, memory_order_relaxed);          // now odd
+        atomic_thread_fence(memory_order_release);
+    }
+
+    void endWrite() {
+        version.store(version.load(memory_order_relaxed) + 1, memory_order_release); // even again
+    }
+
+public:
+    BankAccount(double initialBalance)
+        : version(0), balance(initialBalance), totalDeposited(0), totalWithdrawn(0) {}
+
+    // NON-CONST (Writers): a frozen account CANNOT call these.
+    void deposit(double amount) {
+        lock_guard<mutex> guard(writerLock);
+        beginWrite();
+        balance.store(balance.load(memory_order_relaxed) + amount, memory_order_relaxed);
+        totalDeposited.store(totalDeposited.load(memory_order_relaxed) + amount, memory_order_relaxed);
+        endWrite();
+    }
+
+    void withdraw(double amount) {
+        lock_guard<mutex> guard(writerLock);
+        beginWrite();
+        balance.store(balance.load(memory_order_relaxed) - amount, memory_order_relaxed);
+        totalWithdrawn.store(totalWithdrawn.load(memory_order_relaxed) + amount, memory_order_relaxed);
+        endWrite();
+    }
+
+    // CONST (Reader): works on frozen accounts, never takes a lock,
+    // never makes a writer wait, and always returns all three fields
+    // from the SAME moment in time.
+    AccountSnapshot checkBalance() const {
+        AccountSnapshot s;
+        unsigned before, after;
+        do {
+            before = version.load(memory_order_acquire);
+            s.balance = balance.load(memory_order_relaxed);
+            s.totalDeposited = totalDeposited.load(memory_order_relaxed);
+            s.totalWithdrawn = totalWithdrawn.load(memory_order_relaxed);
+            atomic_thread_fence(memory_order_acquire);
+            after = version.load(memory_order_relaxed);
+        } while (before != after || (before & 1));   // a writer was busy: try again
+        return s;
+    }
+};
+
+// BASELINE: readers take the SAME lock as writers.
+class LockedBankAccount {
+private:
+    double balance, totalDeposited, totalWithdrawn;
+    mutable mutex lock;
+
+public:
+    LockedBankAccount(double initialBalance)
+        : balance(initialBalance), totalDeposited(0), totalWithdrawn(0) {}
+
+    void deposit(double amount) {
+        lock_guard<mutex> guard(lock);
+        balance += amount;
+        totalDeposited += amount;
+    }
+
+    void withdraw(double amount) {
+        lock_guard<mutex> guard(lock);
+        balance -= amount;
+        totalWithdrawn += amount;
+    }
+
+    AccountSnapshot checkBalance() const {
+        lock_guard<mutex> guard(lock);
+        return AccountSnapshot{balance, totalDeposited, totalWithdrawn};
+    }
+};
+
+// One writer keeps changing the account while 'readers' threads read it.
+// Every snapshot must satisfy: balance == opening + deposited - withdrawn.
+template <typename Account>
+void readBenchmark(const char* name, int readers) {
+    const double opening = 5000.00;
+    Account account(opening);
+    atomic<bool> stop(false);
+    atomic<long long> reads(0), torn(0);
+
+    thread writer([&]() {
+        while (!stop.load(memory_order_relaxed)) {
+            account.deposit(10.0);
+            account.withdraw(5.0);
+        }
+    });
+
+    vector<thread> threads;
+    for (int r = 0; r < readers; r++) {
+        threads.emplace_back([&]() {
+            const Account& frozenView = account;   // readers only get a const view
+            long long mine = 0, bad = 0;
+            while (!stop.load(memory_order_relaxed)) {
+                AccountSnapshot s = frozenView.checkBalance();
+                if (s.balance != opening + s.totalDeposited - s.totalWithdrawn)
+                    bad++;
+                mine++;
+            }
+            reads += mine;
+            torn += bad;
+        });
+    }
+
+    this_thread::sleep_for(chrono::milliseconds(500));
+    stop = true;
+    writer.join();
+    for (thread& t : threads) {
+        t.join();
+    }
+
+    cout << name << "\treaders: " << readers
+         << "\treads/sec: " << reads * 2
+         << "\tinconsistent: " << torn << endl;
+}
+
+int main() {
+    // SCENARIO: A "Frozen" view of a LIVE account
+    BankAccount account(5000.00);
+    const BankAccount& frozenView = account;
+
+    account.deposit(250.00);                       // the owner can still write
+    AccountSnapshot s = frozenView.checkBalance(); // ✅ const reader
+    // frozenView.withdraw(500.00);                // ❌ ERROR: const view cannot write
+
+    cout << "--- Bank System ---" << endl;
+    cout << "Current Balance: $" << s.balance
+         << " (deposited $" << s.totalDeposited
+         << ", withdrawn $" << s.totalWithdrawn << ")" << endl;
+
+    // ---------------------------------------------------------
+    // BENCHMARK: reader throughput while a writer is active
+    // ---------------------------------------------------------
+    cout << "\n--- Read Benchmark (1 writer running) ---" << endl;
+    for (int readers = 1; readers <= 4; readers *= 2) {
+        readBenchmark<BankAccount>("seqlock", readers);
+        readBenchmark<LockedBankAccount>("mutex  ", readers);
+    }
+
+    return 0;
+}
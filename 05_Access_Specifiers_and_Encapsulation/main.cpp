@@ -108,3 +108,216 @@ int main() {
     return 0;
 }
 //---------------------------------------------------------------------------
+// Snippet 6 – Batched Transactions (Structure-of-Arrays + SIMD Validation)
+
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <climits>
+#include <chrono>
+#include <random>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+// The per-call class from Snippet 3, without the cout (printing would hide
+// the real cost of the work). Used as the baseline.
+class BankAccount {
+private:
+    int balance;
+
+public:
+    BankAccount() {
+        balance = 0;
+    }
+
+    void deposit(int amount) {
+        if (amount > 0) {
+            balance = balance + amount;
+        }
+    }
+
+    void withdraw(int amount) {
+        if (amount > 0 && amount <= balance) {
+            balance = balance - amount;
+        }
+    }
+
+    int getBalance() const {
+        return balance;
+    }
+};
+
+// A whole batch of transactions stored as STRUCTURE OF ARRAYS:
+// transaction i is (account[i], amount[i], op[i]).
+// Keeping each field in its own array lets the CPU check many of them at once.
+struct TransactionBatch {
+    enum Op : uint8_t { Deposit = 0, Withdraw = 1 };
+
+    vector<int> account;
+    vector<int> amount;
+    vector<uint8_t> op;
+
+    void add(int acc, int amt, Op o) {
+        account.push_back(acc);
+        amount.push_back(amt);
+        op.push_back(o);
+    }
+
+    size_t size() const {
+        return amount.size();
+    }
+};
+
+// Many accounts, one owner. Balances stay PRIVATE; the only way to change
+// them is through applyBatch(), which enforces the same rules as BankAccount.
+class AccountBook {
+private:
+    vector<int> balances;
+
+    // Step 1: returns a mask with bit k set if transaction k can never be
+    // valid (amount <= 0, or no such account), for up to 64 transactions.
+    // These checks do not depend on any balance, so with SSE2 they are done
+    // for 4 transactions in a few instructions.
+    static uint64_t invalidMask(const int* account, const int* amount, size_t count, size_t accounts) {
+        int lastAccount = accounts <= (size_t)INT_MAX ? (int)accounts - 1 : INT_MAX;   // -1: no accounts
+        uint64_t mask = 0;
+        size_t k = 0;
+#if defined(__SSE2__)
+        const __m128i one = _mm_set1_epi32(1);
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i last = _mm_set1_epi32(lastAccount);
+        for (; k + 4 <= count; k += 4) {
+            __m128i amt = _mm_loadu_si128((const __m128i*)(amount + k));
+            __m128i acc = _mm_loadu_si128((const __m128i*)(account + k));
+            __m128i bad = _mm_cmpgt_epi32(one, amt);                    // 1 > amount: amount <= 0
+            bad = _mm_or_si128(bad, _mm_cmplt_epi32(acc, zero));        // negative account
+            bad = _mm_or_si128(bad, _mm_cmpgt_epi32(acc, last));        // account past the end
+            mask |= (uint64_t)_mm_movemask_ps(_mm_castsi128_ps(bad)) << k;
+        }
+#endif
+        for (; k < count; k++) {                      // scalar tail / fallback
+            mask |= (uint64_t)(amount[k] <= 0 || account[k] < 0 || account[k] > lastAccount) << k;
+        }
+        return mask;
+    }
+
+public:
+    // One extra slot at the end: rejected transactions are "applied" there
+    // with a change of 0, so every account stays untouched.
+    explicit AccountBook(size_t accounts) : balances(accounts + 1, 0) {}
+
+    // Applies every transaction in ONE pass and returns a bitmap:
+    // bit i is 1 if transaction i was rejected.
+    vector<uint64_t> applyBatch(const TransactionBatch& batch) {
+        size_t n = batch.size();
+        vector<uint64_t> rejected((n + 63) / 64, 0);
+
+        // The batch is processed 64 transactions at a time, so the fields
+        // checked in Step 1 are still in the CPU cache for Step 2.
+        size_t spare = balances.size() - 1;
+        for (size_t w = 0; w < rejected.size(); w++) {
+            size_t first = w * 64;
+            size_t count = n - first < 64 ? n - first : 64;
+            const uint64_t invalid = invalidMask(&batch.account[first], &batch.amount[first], count, spare);
+            uint64_t bits = 0;
+
+            // Step 2: apply in order. The "amount <= balance" check has to see
+            // the balance AFTER the earlier transactions of this batch (the
+            // same account may appear twice), so it cannot be done in Step 1.
+            for (size_t k = 0; k < count; k++) {
+                size_t i = first + k;
+                int amount = batch.amount[i];
+                bool isWithdraw = batch.op[i] == TransactionBatch::Withdraw;
+
+                // No if: a rejected transaction adds 0 to the spare slot instead
+                // of jumping around the update, so a random mix of good and bad
+                // transactions costs no wrong guesses (branch mispredictions).
+                bool bad = (invalid >> k) & 1;
+                size_t target = bad ? spare : (size_t)batch.account[i];
+                int balance = balances[target];
+                bad = bad || (isWithdraw && amount > balance);
+                int change = isWithdraw ? -amount : amount;
+                balances[target] = balance + (bad ? 0 : change);
+                bits |= (uint64_t)bad << k;
+            }
+            rejected[w] = bits;
+        }
+        return rejected;
+    }
+
+    int getBalance(size_t account) const {
+        return balances[account];
+    }
+};
+
+TransactionBatch makeBatch(size_t n, int accounts) {
+    TransactionBatch batch;
+    mt19937 rng(42);
+    uniform_int_distribution<int> pickAccount(0, accounts - 1);
+    uniform_int_distribution<int> pickAmount(-10, 500);   // some invalid amounts
+    for (size_t i = 0; i < n; i++) {
+        batch.add(pickAccount(rng), pickAmount(rng),
+                  (i % 3 == 0) ? TransactionBatch::Withdraw : TransactionBatch::Deposit);
+    }
+    return batch;
+}
+
+int main() {
+    // ---------------------------------------------------------
+    // SMALL EXAMPLE
+    // ---------------------------------------------------------
+    AccountBook book(2);
+    TransactionBatch batch;
+    batch.add(0, 5000, TransactionBatch::Deposit);    // ok
+    batch.add(0, -20, TransactionBatch::Deposit);     // rejected: amount <= 0
+    batch.add(1, 100, TransactionBatch::Withdraw);    // rejected: balance is 0
+    batch.add(0, 1500, TransactionBatch::Withdraw);   // ok
+    batch.add(7, 100, TransactionBatch::Deposit);     // rejected: there is no account 7
+
+    vector<uint64_t> rejected = book.applyBatch(batch);
+    for (size_t i = 0; i < batch.size(); i++) {
+        cout << "Transaction " << i << ": "
+             << (((rejected[i / 64] >> (i % 64)) & 1) ? "REJECTED" : "applied") << endl;
+    }
+    cout << "Account 0 balance: " << book.getBalance(0) << endl;
+
+    // ---------------------------------------------------------
+    // BENCHMARK: per-call objects vs. one batched pass
+    // ---------------------------------------------------------
+    const int accounts = 100000;
+    const size_t sizes[] = {1000000, 10000000};
+
+    cout << "\n--- Benchmark ---" << endl;
+    for (size_t n : sizes) {
+        TransactionBatch big = makeBatch(n, accounts);
+
+        vector<BankAccount> objects(accounts);
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < n; i++) {
+            if (big.op[i] == TransactionBatch::Withdraw)
+                objects[big.account[i]].withdraw(big.amount[i]);
+            else
+                objects[big.account[i]].deposit(big.amount[i]);
+        }
+        chrono::duration<double, milli> perCall = chrono::steady_clock::now() - start;
+
+        AccountBook engine(accounts);
+        start = chrono::steady_clock::now();
+        vector<uint64_t> bits = engine.applyBatch(big);
+        chrono::duration<double, milli> batched = chrono::steady_clock::now() - start;
+
+        bool same = true;
+        for (int a = 0; a < accounts; a++) {
+            same = same && objects[a].getBalance() == engine.getBalance(a);
+        }
+
+        cout << n << " ops | per-call: " << perCall.count() << " ms"
+             << " | batched: " << batched.count() << " ms"
+             << " | balances match: " << (same ? "yes" : "NO") << endl;
+    }
+
+    return 0;
+}
+//---------------------------------------------------------------------------
@@ -41,3 +41,901 @@ public:
     // This is pure abstraction
 };
 
+
+//---------------------------------------------------------------------------
+// Snippet 4 – Abstraction at Scale: a Fleet of Millions of Cars (SoA + Threads)
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+// Both versions use the same physics, once per fixed time step (1/60 s).
+const int TicksPerSecond = 60;
+const float TickSeconds = 1.0f / TicksPerSecond;
+const float MaxAccel = 3.0f * TickSeconds;     // m/s gained per tick
+const float MaxBrake = 8.0f * TickSeconds;     // m/s lost per tick
+const float FuelPerMetre = 0.0005f;            // litres
+
+// BEFORE: one object per car, updated one at a time through member functions.
+// Every car also carries its model name, so a loop over the speeds drags the
+// names through the cache too.
+class Car {
+public:
+    Car(string m, float fuelLitres, float target)
+        : model(move(m)), position(0), speed(0), targetSpeed(target), fuel(fuelLitres), running(0) {}
+
+    void start() {
+        igniteEngine();
+    }
+
+    void update() {
+        float step = min(max(targetSpeed - speed, -MaxBrake), MaxAccel);
+        speed = speed + step * running;
+        fuel = fuel - speed * TickSeconds * FuelPerMetre;
+        running = fuel > 0 ? running : 0.0f;        // out of fuel: the engine stops
+        fuel = max(fuel, 0.0f);
+        speed = speed * running;
+        position = position + speed * TickSeconds;
+    }
+
+    float getPosition() const { return position; }
+
+private:
+    string model;
+    float position, speed, targetSpeed, fuel;
+    float running;                                 // 1 or 0 (a number, so it can be multiplied)
+
+    void igniteEngine() {
+        running = fuel > 0 ? 1.0f : 0.0f;
+    }
+};
+
+// A small fixed set of threads. run() splits [0, n) into one piece per
+// thread (the calling thread takes the first piece) and waits for all of them.
+class TickPool {
+private:
+    vector<thread> workers;
+    mutex lock;
+    condition_variable wake, finished;
+    function<void(size_t, size_t)> job;
+    size_t total = 0;
+    unsigned round = 0;                            // increases with every run()
+    size_t pending = 0;
+    bool stopping = false;
+
+    // Pieces are multiples of 4 cars, so SIMD groups never straddle two threads
+    void piece(size_t part, size_t& begin, size_t& end) const {
+        size_t parts = workers.size() + 1;
+        size_t size = (total / parts + 3) & ~(size_t)3;
+        begin = min(total, part * size);
+        end = part + 1 == parts ? total : min(total, begin + size);
+    }
+
+    void work(size_t part) {
+        unsigned seen = 0;
+        while (true) {
+            unique_lock<mutex> guard(lock);
+            wake.wait(guard, [&] { return stopping || round != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = round;
+            size_t begin, end;
+            piece(part, begin, end);
+            guard.unlock();
+
+            job(begin, end);
+
+            guard.lock();
+            if (--pending == 0) {
+                finished.notify_one();
+            }
+        }
+    }
+
+public:
+    explicit TickPool(unsigned threads) {
+        for (unsigned t = 1; t < threads; t++) {
+            workers.emplace_back(&TickPool::work, this, (size_t)t);
+        }
+    }
+
+    TickPool(const TickPool&) = delete;
+    TickPool& operator=(const TickPool&) = delete;
+
+    ~TickPool() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (thread& w : workers) {
+            w.join();
+        }
+    }
+
+    void run(size_t n, function<void(size_t, size_t)> task) {
+        {
+            lock_guard<mutex> guard(lock);
+            job = move(task);
+            total = n;
+            pending = workers.size();
+            round++;
+        }
+        wake.notify_all();
+
+        size_t begin, end;
+        piece(0, begin, end);
+        job(begin, end);
+
+        unique_lock<mutex> guard(lock);
+        finished.wait(guard, [&] { return pending == 0; });
+    }
+};
+
+// AFTER: the user still only sees start() and advance(). HOW the cars are
+// stored and updated is hidden:
+// - STRUCTURE OF ARRAYS (SoA): one array per field, so the update loop reads
+//   only the numbers it needs, one after another.
+// - The update kernel handles 4 cars per instruction (SSE2).
+// - The cars are split between the threads of a TickPool.
+class Fleet {
+public:
+    explicit Fleet(unsigned threads) : pool(threads), leftover(0) {}
+
+    size_t addCar(const string& model, float fuelLitres, float target) {
+        models.push_back(model);
+        position.push_back(0);
+        speed.push_back(0);
+        targetSpeed.push_back(target);
+        fuel.push_back(fuelLitres);
+        running.push_back(0);
+        return models.size() - 1;
+    }
+
+    void start(size_t car) {
+        igniteEngine(car);
+    }
+
+    void startAll() {
+        for (size_t car = 0; car < models.size(); car++) {
+            igniteEngine(car);
+        }
+    }
+
+    // FIXED TIME STEP: real time is cut into whole ticks of 1/60 s, so the
+    // result does not depend on how often advance() is called. The rest is
+    // kept for the next call.
+    int advance(double seconds) {
+        leftover += seconds;
+        int ticks = (int)floor(leftover * TicksPerSecond + 1e-9);
+        for (int t = 0; t < ticks; t++) {
+            tick();
+        }
+        leftover -= (double)ticks / TicksPerSecond;
+        return ticks;
+    }
+
+    void tick() {
+        pool.run(models.size(), [this](size_t begin, size_t end) { update(begin, end); });
+    }
+
+    size_t size() const { return models.size(); }
+    float getPosition(size_t car) const { return position[car]; }
+
+private:
+    vector<string> models;                         // not touched by the update loop
+    vector<float> position, speed, targetSpeed, fuel, running;
+    TickPool pool;
+    double leftover;
+
+    void igniteEngine(size_t car) {
+        running[car] = fuel[car] > 0 ? 1.0f : 0.0f;
+    }
+
+    // Exactly the same steps as Car::update(), for cars [begin, end)
+    void update(size_t begin, size_t end) {
+        float* pos = position.data();
+        float* spd = speed.data();
+        const float* target = targetSpeed.data();
+        float* fl = fuel.data();
+        float* on = running.data();
+        size_t i = begin;
+#if defined(__SSE2__)
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 brake = _mm_set1_ps(-MaxBrake);
+        const __m128 accel = _mm_set1_ps(MaxAccel);
+        const __m128 dt = _mm_set1_ps(TickSeconds);
+        const __m128 burn = _mm_set1_ps(FuelPerMetre);
+        for (; i + 4 <= end; i += 4) {
+            __m128 s = _mm_loadu_ps(spd + i);
+            __m128 f = _mm_loadu_ps(fl + i);
+            __m128 r = _mm_loadu_ps(on + i);
+            __m128 step = _mm_min_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(target + i), s), brake), accel);
+            s = _mm_add_ps(s, _mm_mul_ps(step, r));
+            f = _mm_sub_ps(f, _mm_mul_ps(_mm_mul_ps(s, dt), burn));
+            r = _mm_and_ps(r, _mm_cmpgt_ps(f, zero));      // keep 'running' only where fuel > 0
+            f = _mm_max_ps(f, zero);
+            s = _mm_mul_ps(s, r);
+            _mm_storeu_ps(spd + i, s);
+            _mm_storeu_ps(fl + i, f);
+            _mm_storeu_ps(on + i, r);
+            _mm_storeu_ps(pos + i, _mm_add_ps(_mm_loadu_ps(pos + i), _mm_mul_ps(s, dt)));
+        }
+#endif
+        for (; i < end; i++) {
+            float step = min(max(target[i] - spd[i], -MaxBrake), MaxAccel);
+            spd[i] = spd[i] + step * on[i];
+            fl[i] = fl[i] - spd[i] * TickSeconds * FuelPerMetre;
+            on[i] = fl[i] > 0 ? on[i] : 0.0f;
+            fl[i] = max(fl[i], 0.0f);
+            spd[i] = spd[i] * on[i];
+            pos[i] = pos[i] + spd[i] * TickSeconds;
+        }
+    }
+};
+
+unsigned long long nextRandom(unsigned long long& state) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return state >> 33;
+}
+
+int main() {
+    // The user's view is the same as with one Car: create, start, let time pass.
+    Fleet demo(2);
+    size_t civic = demo.addCar("Honda Civic", 40.0f, 27.0f);
+    demo.start(civic);
+    int ticks = demo.advance(2.0);
+    cout << "Honda Civic after " << ticks << " ticks: " << demo.getPosition(civic) << " m" << endl;
+
+    // ---------------------------------------------------------
+    // BENCHMARK: 1M cars, 10 simulated seconds (600 ticks)
+    // Fuel is 0 to 0.05 litres, so some cars run dry along the way.
+    // ---------------------------------------------------------
+    const size_t cars = 1000000;
+    const double simulated = 10.0;
+    vector<float> fuelOf(cars), targetOf(cars);
+    unsigned long long seed = 19;
+    for (size_t i = 0; i < cars; i++) {
+        fuelOf[i] = (float)(nextRandom(seed) % 5000) / 100000.0f;
+        targetOf[i] = 10.0f + (float)(nextRandom(seed) % 2000) / 100.0f;
+    }
+
+    vector<Car> objects;
+    objects.reserve(cars);
+    for (size_t i = 0; i < cars; i++) {
+        objects.emplace_back("Honda Civic", fuelOf[i], targetOf[i]);
+        objects.back().start();
+    }
+    int objectTicks = (int)lround(simulated * TicksPerSecond);
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < objectTicks; t++) {
+        for (Car& car : objects) {
+            car.update();
+        }
+    }
+    chrono::duration<double> objectTime = chrono::steady_clock::now() - start;
+    double objectDistance = 0;
+    for (const Car& car : objects) objectDistance += car.getPosition();
+
+    cout << "\n--- " << cars / 1000000 << "M cars, " << objectTicks << " ticks ---" << endl;
+    cout << "\t\t\tcars updated/s (millions)" << endl;
+    cout << "vector<Car>, 1 thread\t" << cars * objectTicks / objectTime.count() / 1e6 << endl;
+
+    for (unsigned threads = 1; threads <= 8; threads *= 2) {
+        Fleet fleet(threads);
+        for (size_t i = 0; i < cars; i++) {
+            fleet.addCar("Honda Civic", fuelOf[i], targetOf[i]);
+        }
+        fleet.startAll();
+
+        start = chrono::steady_clock::now();
+        int fleetTicks = fleet.advance(simulated);
+        chrono::duration<double> fleetTime = chrono::steady_clock::now() - start;
+
+        double fleetDistance = 0;
+        for (size_t i = 0; i < cars; i++) fleetDistance += fleet.getPosition(i);
+        cout << "Fleet, " << threads << " thread" << (threads > 1 ? "s" : " ") << "\t\t"
+             << cars * fleetTicks / fleetTime.count() / 1e6
+             << (fleetTicks == objectTicks && fleetDistance == objectDistance ? "\t(same result)" : "\t(DIFFERENT!)") << endl;
+    }
+    cout << "Total distance: " << objectDistance / 1000 << " km" << endl;
+
+    return 0;
+}
+
+
+//---------------------------------------------------------------------------
+// Snippet 5 – Drawing Millions of Shapes: Virtual Calls vs. Type-Sorted Batches
+
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <variant>
+#include <chrono>
+#include <cmath>
+using namespace std;
+
+// The same abstract class as Snippet 3. draw() has no real screen yet, so
+// every shape remembers the area it painted, and lastInk() reads it back.
+// Every drawing loop adds these up in a local variable and adds the total
+// to 'inkUsed' ONCE at the end (a store to a static on every shape would
+// make each draw() wait for the one before).
+class Shape {
+protected:
+    double painted = 0;                 // ink used by the last draw()
+
+public:
+    static double inkUsed;
+
+    virtual void draw() = 0;
+    double lastInk() const { return painted; }       // not virtual: no lookup
+    virtual ~Shape() {}
+};
+
+double Shape::inkUsed = 0;
+
+// 'final': no class can derive from these, so when the compiler knows the
+// exact type it can call draw() directly (and inline it) instead of
+// looking it up in the virtual table.
+class Circle final : public Shape {
+public:
+    float x, y, radius;
+    Circle(float cx, float cy, float r) : x(cx), y(cy), radius(r) {}
+    void draw() override { painted = 3.14159265 * radius * radius; }
+};
+
+class Rectangle final : public Shape {
+public:
+    float x, y, width, height;
+    Rectangle(float left, float top, float w, float h) : x(left), y(top), width(w), height(h) {}
+    void draw() override { painted = width * height; }
+};
+
+class Triangle final : public Shape {
+public:
+    float ax, ay, bx, by, cx, cy;
+    Triangle(float x1, float y1, float x2, float y2, float x3, float y3)
+        : ax(x1), ay(y1), bx(x2), by(y2), cx(x3), cy(y3) {}
+    void draw() override { painted = 0.5f * fabs((bx - ax) * (cy - ay) - (cx - ax) * (by - ay)); }
+};
+
+// TYPE-SORTED STORE: one contiguous array per shape type.
+// drawAll() runs one tight loop per type: no virtual call, no pointer to
+// follow, and the next shapes are already on their way from memory.
+class ShapeStore {
+private:
+    vector<Circle> circles;
+    vector<Rectangle> rectangles;
+    vector<Triangle> triangles;
+
+public:
+    void add(const Circle& c) { circles.push_back(c); }
+    void add(const Rectangle& r) { rectangles.push_back(r); }
+    void add(const Triangle& t) { triangles.push_back(t); }
+
+    size_t size() const { return circles.size() + rectangles.size() + triangles.size(); }
+
+    void drawAll() {
+        double ink = 0;
+        for (Circle& c : circles) { c.draw(); ink += c.lastInk(); }   // the exact type is known: direct call
+        for (Rectangle& r : rectangles) { r.draw(); ink += r.lastInk(); }
+        for (Triangle& t : triangles) { t.draw(); ink += t.lastInk(); }
+        Shape::inkUsed += ink;
+    }
+
+    // The Shape interface still works: code written for 'Shape&' can visit
+    // every shape (one virtual call per shape again, as it chooses).
+    template <typename Function>
+    void forEachShape(Function f) {
+        for (Circle& c : circles) f(static_cast<Shape&>(c));
+        for (Rectangle& r : rectangles) f(static_cast<Shape&>(r));
+        for (Triangle& t : triangles) f(static_cast<Shape&>(t));
+    }
+};
+
+typedef variant<Circle, Rectangle, Triangle> AnyShape;
+
+unsigned long long nextRandom(unsigned long long& state) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return state >> 33;
+}
+
+float randomFloat(unsigned long long& seed) {
+    return (float)(nextRandom(seed) % 1000) / 10.0f;
+}
+
+// The same random scene for every approach: calls add(shape) 'count' times
+template <typename Add>
+void makeScene(size_t count, Add add) {
+    unsigned long long seed = 24;
+    for (size_t i = 0; i < count; i++) {
+        switch (nextRandom(seed) % 3) {
+        case 0: add(Circle(randomFloat(seed), randomFloat(seed), randomFloat(seed))); break;
+        case 1: add(Rectangle(randomFloat(seed), randomFloat(seed), randomFloat(seed), randomFloat(seed))); break;
+        default: add(Triangle(randomFloat(seed), randomFloat(seed), randomFloat(seed),
+                              randomFloat(seed), randomFloat(seed), randomFloat(seed))); break;
+        }
+    }
+}
+
+// Runs 'drawEverything' 5 times and returns ns per shape; 'ink' gets the result of one pass
+template <typename Draw>
+double nanosPerShape(size_t count, double& ink, Draw drawEverything) {
+    const int passes = 5;
+    Shape::inkUsed = 0;
+    auto start = chrono::steady_clock::now();
+    for (int p = 0; p < passes; p++) drawEverything();
+    chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+    ink = Shape::inkUsed / passes;
+    return elapsed.count() / passes / count;
+}
+
+int main() {
+    ShapeStore small;
+    small.add(Circle(0, 0, 1));
+    small.add(Rectangle(0, 0, 2, 3));
+    small.add(Triangle(0, 0, 4, 0, 0, 2));
+    small.drawAll();
+    cout << "Ink used by 3 shapes (batches):        " << Shape::inkUsed << endl;
+    Shape::inkUsed = 0;
+    small.forEachShape([](Shape& s) { s.draw(); Shape::inkUsed += s.lastInk(); });
+    cout << "Ink used by 3 shapes (through Shape&): " << Shape::inkUsed << endl;
+
+    // ---------------------------------------------------------
+    // BENCHMARK: 10M shapes in random type order
+    // ---------------------------------------------------------
+    const size_t count = 10000000;
+    double virtualInk, variantInk, batchInk;
+    double virtualTime, variantTime, batchTime;
+    {
+        vector<unique_ptr<Shape>> shapes;
+        makeScene(count, [&shapes](auto shape) { shapes.push_back(make_unique<decltype(shape)>(shape)); });
+        virtualTime = nanosPerShape(count, virtualInk, [&shapes]() {
+            double ink = 0;
+            for (unique_ptr<Shape>& s : shapes) { s->draw(); ink += s->lastInk(); }   // virtual call per shape
+            Shape::inkUsed += ink;
+        });
+    }
+    {
+        vector<AnyShape> shapes;
+        makeScene(count, [&shapes](auto shape) { shapes.push_back(shape); });
+        variantTime = nanosPerShape(count, variantInk, [&shapes]() {
+            double ink = 0;
+            for (AnyShape& s : shapes) {
+                ink += visit([](auto& exact) { exact.draw(); return exact.lastInk(); }, s);   // switch on the type
+            }
+            Shape::inkUsed += ink;
+        });
+    }
+    {
+        ShapeStore store;
+        makeScene(count, [&store](auto shape) { store.add(shape); });
+        batchTime = nanosPerShape(count, batchInk, [&store]() { store.drawAll(); });
+    }
+
+    cout << "\n--- " << count / 1000000 << "M shapes (ns per shape) ---" << endl;
+    cout << "vector<unique_ptr<Shape>>, virtual draw()\t" << virtualTime << endl;
+    cout << "vector<variant>, visit\t\t\t\t" << variantTime << endl;
+    cout << "ShapeStore, type-sorted batches\t\t\t" << batchTime << endl;
+    // The batches add the same numbers in a different order, so the last
+    // digits of a 10M-term sum differ: compare to 1 part in a million.
+    bool same = fabs(variantInk - virtualInk) < 1e-6 * virtualInk && fabs(batchInk - virtualInk) < 1e-6 * virtualInk;
+    cout << "Ink: " << virtualInk << (same ? " (same for all three)" : " (DIFFERENT!)") << endl;
+
+    return 0;
+}
+
+
+//---------------------------------------------------------------------------
+// Snippet 6 – A Real Screen Behind draw(): Tiled, Multithreaded Rasterizer
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+using namespace std;
+
+// The picture in memory: one 0xRRGGBB number per pixel
+class Framebuffer {
+public:
+    int width, height;
+    vector<uint32_t> pixels;
+
+    Framebuffer(int w, int h) : width(w), height(h), pixels((size_t)w * h, 0) {}
+
+    // PPM: a tiny header, then 3 bytes per pixel. Any image viewer opens it.
+    bool writePPM(const char* path) const {
+        FILE* out = fopen(path, "wb");
+        if (!out) {
+            return false;
+        }
+        fprintf(out, "P6\n%d %d\n255\n", width, height);
+        vector<unsigned char> row((size_t)width * 3);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                uint32_t p = pixels[(size_t)y * width + x];
+                row[3 * x] = (unsigned char)(p >> 16);
+                row[3 * x + 1] = (unsigned char)(p >> 8);
+                row[3 * x + 2] = (unsigned char)p;
+            }
+            fwrite(row.data(), 1, row.size(), out);
+        }
+        return fclose(out) == 0;
+    }
+};
+
+// A rectangle of the screen [x0, x1) x [y0, y1). draw() only touches pixels
+// inside its tile, so two threads drawing two tiles never touch the same pixel.
+struct Tile {
+    Framebuffer* target;
+    int x0, y0, x1, y1;
+
+    uint32_t* row(int y) { return &target->pixels[(size_t)y * target->width]; }
+
+    // Fills pixels [from, to] of row y, clipped to the tile
+    void span(int y, int from, int to, uint32_t color) {
+        from = max(from, x0);
+        to = min(to, x1 - 1);
+        if (from <= to) {
+            fill(row(y) + from, row(y) + to + 1, color);
+        }
+    }
+};
+
+struct Bounds {
+    float left, top, right, bottom;
+};
+
+// The abstract interface now has a real output target. A pixel is covered
+// when its CENTRE (x + 0.5, y + 0.5) is inside the shape. That rule does not
+// depend on the tile, so tiled and whole-screen drawing give the same pixels.
+class Shape {
+public:
+    uint32_t color;
+
+    explicit Shape(uint32_t c) : color(c) {}
+    virtual ~Shape() {}
+
+    virtual Bounds bounds() const = 0;
+    virtual void draw(Tile& tile) const = 0;
+};
+
+class Circle : public Shape {
+public:
+    float cx, cy, radius;
+    Circle(float x, float y, float r, uint32_t c) : Shape(c), cx(x), cy(y), radius(r) {}
+
+    Bounds bounds() const override {
+        return Bounds{cx - radius, cy - radius, cx + radius, cy + radius};
+    }
+
+    void draw(Tile& tile) const override {
+        int top = max(tile.y0, (int)floor(cy - radius));
+        int bottom = min(tile.y1 - 1, (int)ceil(cy + radius));
+        for (int y = top; y <= bottom; y++) {
+            float dy = y + 0.5f - cy;
+            float rest = radius * radius - dy * dy;
+            if (rest < 0) {
+                continue;
+            }
+            float half = sqrt(rest);
+            tile.span(y, (int)ceil(cx - half - 0.5f), (int)floor(cx + half - 0.5f), color);
+        }
+    }
+};
+
+class Rectangle : public Shape {
+public:
+    float x, y, width, height;
+    Rectangle(float left, float top, float w, float h, uint32_t c) : Shape(c), x(left), y(top), width(w), height(h) {}
+
+    Bounds bounds() const override {
+        return Bounds{x, y, x + width, y + height};
+    }
+
+    void draw(Tile& tile) const override {
+        int top = max(tile.y0, (int)ceil(y - 0.5f));
+        int bottom = min(tile.y1 - 1, (int)ceil(y + height - 0.5f) - 1);
+        int left = (int)ceil(x - 0.5f);
+        int right = (int)ceil(x + width - 0.5f) - 1;
+        for (int row = top; row <= bottom; row++) {
+            tile.span(row, left, right, color);
+        }
+    }
+};
+
+class Triangle : public Shape {
+public:
+    float ax, ay, bx, by, cx, cy;
+    Triangle(float x1, float y1, float x2, float y2, float x3, float y3, uint32_t c)
+        : Shape(c), ax(x1), ay(y1), bx(x2), by(y2), cx(x3), cy(y3) {}
+
+    Bounds bounds() const override {
+        return Bounds{min({ax, bx, cx}), min({ay, by, cy}), max({ax, bx, cx}), max({ay, by, cy})};
+    }
+
+    void draw(Tile& tile) const override {
+        Bounds b = bounds();
+        int left = max(tile.x0, (int)floor(b.left));
+        int right = min(tile.x1 - 1, (int)ceil(b.right));
+        int top = max(tile.y0, (int)floor(b.top));
+        int bottom = min(tile.y1 - 1, (int)ceil(b.bottom));
+        float area = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+        if (area == 0) {
+            return;
+        }
+        float sign = area > 0 ? 1.0f : -1.0f;     // accept both corner orders
+        for (int y = top; y <= bottom; y++) {
+            uint32_t* row = tile.row(y);
+            float py = y + 0.5f;
+            for (int x = left; x <= right; x++) {
+                float px = x + 0.5f;
+                // "edge functions": which side of each edge the pixel centre is on
+                float e0 = ((bx - ax) * (py - ay) - (by - ay) * (px - ax)) * sign;
+                float e1 = ((cx - bx) * (py - by) - (cy - by) * (px - bx)) * sign;
+                float e2 = ((ax - cx) * (py - cy) - (ay - cy) * (px - cx)) * sign;
+                if (e0 >= 0 && e1 >= 0 && e2 >= 0) {
+                    row[x] = color;
+                }
+            }
+        }
+    }
+};
+
+// WORK-STEALING POOL: every thread has its own queue of tasks. A thread takes
+// tasks from the FRONT of its own queue; when that is empty it STEALS from the
+// BACK of another thread's queue. A thread that got the expensive tiles is
+// helped by the others instead of everyone waiting for it.
+class StealingPool {
+private:
+    struct Queue {
+        mutex lock;
+        deque<size_t> tasks;
+    };
+
+    vector<unique_ptr<Queue>> queues;              // [0] belongs to the thread calling run()
+    vector<thread> workers;
+    mutex lock;
+    condition_variable wake, finished;
+    function<void(size_t)> job;
+    unsigned round = 0;
+    size_t busy = 0;
+    bool stopping = false;
+
+    bool take(size_t me, size_t& task) {
+        {
+            lock_guard<mutex> guard(queues[me]->lock);
+            if (!queues[me]->tasks.empty()) {
+                task = queues[me]->tasks.front();
+                queues[me]->tasks.pop_front();
+                return true;
+            }
+        }
+        for (size_t i = 1; i < queues.size(); i++) {
+            Queue& victim = *queues[(me + i) % queues.size()];
+            lock_guard<mutex> guard(victim.lock);
+            if (!victim.tasks.empty()) {
+                task = victim.tasks.back();
+                victim.tasks.pop_back();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void drain(size_t me) {
+        size_t task;
+        while (take(me, task)) {
+            job(task);
+        }
+    }
+
+    void work(size_t me) {
+        unsigned seen = 0;
+        while (true) {
+            {
+                unique_lock<mutex> guard(lock);
+                wake.wait(guard, [&] { return stopping || round != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = round;
+            }
+            drain(me);
+            lock_guard<mutex> guard(lock);
+            if (--busy == 0) {
+                finished.notify_one();
+            }
+        }
+    }
+
+public:
+    explicit StealingPool(unsigned threads) {
+        for (unsigned t = 0; t < threads; t++) {
+            queues.push_back(make_unique<Queue>());
+        }
+        for (unsigned t = 1; t < threads; t++) {
+            workers.emplace_back(&StealingPool::work, this, (size_t)t);
+        }
+    }
+
+    StealingPool(const StealingPool&) = delete;
+    StealingPool& operator=(const StealingPool&) = delete;
+
+    ~StealingPool() {
+        {
+            lock_guard<mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (thread& w : workers) {
+            w.join();
+        }
+    }
+
+    // Runs task(0) ... task(n - 1) on all threads and waits for them
+    void run(size_t n, function<void(size_t)> task) {
+        for (size_t t = 0; t < n; t++) {
+            queues[t % queues.size()]->tasks.push_back(t);   // no thread is running yet
+        }
+        {
+            lock_guard<mutex> guard(lock);
+            job = move(task);
+            busy = workers.size();
+            round++;
+        }
+        wake.notify_all();
+        drain(0);
+        unique_lock<mutex> guard(lock);
+        finished.wait(guard, [&] { return busy == 0; });
+    }
+};
+
+// THE RENDERER
+// 1. BINNING: every shape is added to the list of each 64x64 tile its bounds
+//    touch (in drawing order, so overlaps come out the same).
+// 2. Every tile is one task: clear it, then draw its shapes, clipped to it.
+class TiledRenderer {
+private:
+    static const int TileSize = 64;
+    StealingPool pool;
+    vector<vector<uint32_t>> bins;
+
+public:
+    explicit TiledRenderer(unsigned threads) : pool(threads) {}
+
+    void render(const vector<unique_ptr<Shape>>& scene, Framebuffer& frame, uint32_t background) {
+        int columns = (frame.width + TileSize - 1) / TileSize;
+        int rows = (frame.height + TileSize - 1) / TileSize;
+        bins.resize((size_t)columns * rows);
+        for (vector<uint32_t>& bin : bins) bin.clear();
+
+        for (uint32_t s = 0; s < scene.size(); s++) {
+            Bounds b = scene[s]->bounds();
+            int left = max(0, (int)floor(b.left) / TileSize);
+            int right = min(columns - 1, (int)ceil(b.right) / TileSize);
+            int top = max(0, (int)floor(b.top) / TileSize);
+            int bottom = min(rows - 1, (int)ceil(b.bottom) / TileSize);
+            for (int ty = top; ty <= bottom; ty++) {
+                for (int tx = left; tx <= right; tx++) {
+                    bins[(size_t)ty * columns + tx].push_back(s);
+                }
+            }
+        }
+
+        pool.run(bins.size(), [&, columns](size_t t) {
+            int tx = (int)(t % columns), ty = (int)(t / columns);
+            Tile tile{&frame, tx * TileSize, ty * TileSize,
+                      min(frame.width, (tx + 1) * TileSize), min(frame.height, (ty + 1) * TileSize)};
+            for (int y = tile.y0; y < tile.y1; y++) {
+                tile.span(y, tile.x0, tile.x1 - 1, background);
+            }
+            for (uint32_t s : bins[t]) {
+                scene[s]->draw(tile);                 // the same Shape::draw interface
+            }
+        });
+    }
+};
+
+// REFERENCE: one thread, no tiles: the whole screen is a single "tile"
+void renderReference(const vector<unique_ptr<Shape>>& scene, Framebuffer& frame, uint32_t background) {
+    fill(frame.pixels.begin(), frame.pixels.end(), background);
+    Tile whole{&frame, 0, 0, frame.width, frame.height};
+    for (const unique_ptr<Shape>& s : scene) {
+        s->draw(whole);
+    }
+}
+
+unsigned long long nextRandom(unsigned long long& state) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return state >> 33;
+}
+
+float randomFloat(unsigned long long& seed, float limit) {
+    return (float)(nextRandom(seed) % 100000) / 100000.0f * limit;
+}
+
+vector<unique_ptr<Shape>> makeScene(size_t count, int width, int height) {
+    vector<unique_ptr<Shape>> scene;
+    unsigned long long seed = 25;
+    for (size_t i = 0; i < count; i++) {
+        float x = randomFloat(seed, (float)width), y = randomFloat(seed, (float)height);
+        uint32_t color = (uint32_t)(nextRandom(seed) & 0xFFFFFF);
+        switch (nextRandom(seed) % 3) {
+        case 0:
+            scene.push_back(make_unique<Circle>(x, y, 3 + randomFloat(seed, 60), color));
+            break;
+        case 1:
+            scene.push_back(make_unique<Rectangle>(x, y, 5 + randomFloat(seed, 120), 5 + randomFloat(seed, 80), color));
+            break;
+        default: {
+            float x2 = x + randomFloat(seed, 160) - 80, y2 = y + randomFloat(seed, 160) - 80;
+            float x3 = x + randomFloat(seed, 160) - 80, y3 = y + randomFloat(seed, 160) - 80;
+            scene.push_back(make_unique<Triangle>(x, y, x2, y2, x3, y3, color));
+            break;
+        }
+        }
+    }
+    return scene;
+}
+
+// Run with --save to also write the reference frame to frame.ppm
+int main(int argc, char* argv[]) {
+    const int width = 1920, height = 1080;
+    const uint32_t background = 0x202020;
+    vector<unique_ptr<Shape>> scene = makeScene(20000, width, height);
+
+    Framebuffer reference(width, height);
+    auto start = chrono::steady_clock::now();
+    renderReference(scene, reference, background);
+    chrono::duration<double> referenceTime = chrono::steady_clock::now() - start;
+    if (argc > 1 && strcmp(argv[1], "--save") == 0 && reference.writePPM("frame.ppm")) {
+        cout << "Wrote frame.ppm (" << width << "x" << height << ", " << scene.size() << " shapes)" << endl;
+    }
+
+    // ---------------------------------------------------------
+    // BENCHMARK: frames per second for 1 to 8 threads; every frame must be
+    // pixel-for-pixel identical to the single-threaded reference
+    // ---------------------------------------------------------
+    cout << "\n--- Frames per second ---" << endl;
+    cout << "reference, 1 thread, no tiles\t" << 1.0 / referenceTime.count() << endl;
+    const int frames = 20;
+    for (unsigned threads = 1; threads <= 8; threads *= 2) {
+        TiledRenderer renderer(threads);
+        Framebuffer frame(width, height);
+        bool identical = true;
+        start = chrono::steady_clock::now();
+        for (int f = 0; f < frames; f++) {
+            renderer.render(scene, frame, background);
+            identical = identical && memcmp(frame.pixels.data(), reference.pixels.data(),
+                                            frame.pixels.size() * sizeof(uint32_t)) == 0;
+        }
+        chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+        cout << "tiled, " << threads << " thread" << (threads > 1 ? "s" : " ") << "\t\t\t"
+             << frames / elapsed.count() << (identical ? "\t(pixel-exact)" : "\t(DIFFERENT!)") << endl;
+    }
+
+    return 0;
+}
@@ -148,3 +148,685 @@ int main() {
     return 0;
 }
 
+//-------------------------------------------------------------------------------
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+/*
+    REAL-WORLD PROBLEM:
+    The BankAccount above lives only in memory. When the destructor prints
+    "Account closed", the balance is gone forever (and a crash loses it too).
+
+    SOLUTION: a WRITE-AHEAD JOURNAL
+    - Every deposit/withdraw is first written to a file (the journal).
+    - Each record is: [length][checksum][data], so a half-written record
+      at the end of the file (crash in the middle of a write) is detected.
+    - fsync() forces data to the disk, but it is slow. With GROUP COMMIT,
+      many threads wait together and ONE fsync() makes all of them durable.
+    - On startup, recover() replays the journal to rebuild every balance.
+*/
+
+// Small CRC-32 (the same checksum used by zip files) to detect damaged records.
+struct Crc32Table {
+    uint32_t entry[256];
+
+    Crc32Table() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            entry[i] = c;
+        }
+    }
+};
+
+uint32_t crc32(const unsigned char* data, size_t length) {
+    static const Crc32Table table;    // built once, thread-safe since C++11
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; i++)
+        crc = table.entry[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+// One journal entry. The balance change is stored as a signed delta,
+// so replaying is just "balance += delta".
+struct JournalRecord {
+    int32_t accountId;
+    int32_t delta;
+};
+
+class Journal {
+private:
+    int fd;
+
+    mutex lock;
+    condition_variable flushed;
+    vector<unsigned char> pending;   // records waiting for the next fsync
+    uint64_t nextSeq;                // sequence number of the next record
+    uint64_t durableSeq;             // every record below this is on disk
+    bool flushing;                   // is some thread writing right now?
+    bool broken;                     // open/write/sync failed: nothing new is durable any more
+    off_t durableEnd;                // file size after the last synced batch
+
+    // Statistics for the benchmark
+    uint64_t batches;
+
+public:
+    explicit Journal(const char* path) : nextSeq(0), durableSeq(0), flushing(false), broken(false), batches(0) {
+        fd = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+        durableEnd = fd >= 0 ? lseek(fd, 0, SEEK_END) : -1;
+        if (fd < 0 || durableEnd < 0) {
+            perror("open journal");
+            broken = true;
+        }
+    }
+
+    ~Journal() {
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+
+    // STEP 1: add the record to the in-memory batch. Cheap, never touches the disk.
+    // Format: [uint32 length][uint32 crc32][payload]
+    uint64_t append(const JournalRecord& record) {
+        unsigned char payload[sizeof(JournalRecord)];
+        memcpy(payload, &record, sizeof(record));
+        uint32_t length = sizeof(payload);
+        uint32_t crc = crc32(payload, sizeof(payload));
+
+        unsigned char header[8];
+        memcpy(header, &length, 4);
+        memcpy(header + 4, &crc, 4);
+
+        lock_guard<mutex> guard(lock);
+        pending.insert(pending.end(), header, header + 8);
+        pending.insert(pending.end(), payload, payload + sizeof(payload));
+        return nextSeq++;
+    }
+
+    // STEP 2: wait until the record is on disk.
+    // The first waiter becomes the LEADER: it takes EVERYTHING that is pending
+    // (its own record plus all records other threads added meanwhile),
+    // writes it with one write() and one fsync(), then wakes everybody up.
+    // Returns false if the record could NOT be made durable. A failed write or
+    // sync breaks the journal for good, and the file is cut back to the end of
+    // the last synced batch: complete records of the failed batch must not be
+    // replayed by recover(), because their callers were told "not saved".
+    bool waitDurable(uint64_t seq) {
+        unique_lock<mutex> guard(lock);
+        while (durableSeq <= seq) {
+            if (broken) {
+                return false;
+            }
+            if (flushing) {
+                flushed.wait(guard);          // a leader is already working for us
+                continue;
+            }
+
+            flushing = true;
+            vector<unsigned char> batch;
+            batch.swap(pending);
+            uint64_t batchEnd = nextSeq;
+            guard.unlock();                   // others can keep appending during fsync
+
+            bool ok = true;
+            size_t written = 0;
+            while (ok && written < batch.size()) {
+                ssize_t n = write(fd, batch.data() + written, batch.size() - written);
+                if (n < 0 && errno == EINTR) {
+                    continue;                 // interrupted by a signal: just try again
+                }
+                if (n <= 0) {
+                    perror("write journal");
+                    ok = false;
+                } else {
+                    written += (size_t)n;
+                }
+            }
+            if (ok && fdatasync(fd) != 0) {
+                perror("fdatasync journal");
+                ok = false;
+            }
+
+            if (!ok && ftruncate(fd, durableEnd) != 0) {
+                perror("truncate journal");   // nothing more we can do: still report failure
+            }
+
+            guard.lock();
+            if (ok) {
+                durableSeq = batchEnd;        // only a batch that was written AND synced
+                durableEnd += (off_t)batch.size();
+                batches++;
+            } else {
+                broken = true;                // every waiter wakes up and returns false
+            }
+            flushing = false;
+            flushed.notify_all();
+        }
+        return true;
+    }
+
+    bool commit(const JournalRecord& record) {
+        return waitDurable(append(record));
+    }
+
+    bool isBroken() {
+        lock_guard<mutex> guard(lock);
+        return broken;
+    }
+
+    uint64_t batchCount() {
+        lock_guard<mutex> guard(lock);
+        return batches;
+    }
+
+    // CRASH RECOVERY: read the journal from the start and replay every valid
+    // record. A torn or damaged record can only be at the end (we always
+    // append), so we stop there and cut it off.
+    static map<int, int> recover(const char* path) {
+        map<int, int> balances;
+        int in = open(path, O_RDWR);
+        if (in < 0) {
+            return balances;                  // no journal yet: nothing to recover
+        }
+
+        off_t validEnd = 0;
+        unsigned char header[8];
+        unsigned char payload[sizeof(JournalRecord)];
+        while (read(in, header, 8) == 8) {
+            uint32_t length, crc;
+            memcpy(&length, header, 4);
+            memcpy(&crc, header + 4, 4);
+            if (length != sizeof(payload) || read(in, payload, length) != (ssize_t)length ||
+                crc32(payload, length) != crc) {
+                break;
+            }
+            JournalRecord record;
+            memcpy(&record, payload, sizeof(record));
+            balances[record.accountId] += record.delta;
+            validEnd += 8 + length;
+        }
+
+        if (ftruncate(in, validEnd) != 0) {
+            perror("truncate journal");
+        }
+        close(in);
+        return balances;
+    }
+};
+
+class DurableBankAccount {
+
+private:
+    int id;
+    int balance;         // confirmed deposits only: a deposit still on its way
+                         // to the disk cannot be withdrawn yet
+    mutex lock;          // keeps "check + log + apply" together for this account
+    Journal& journal;
+
+public:
+    // CONSTRUCTOR
+    // The starting balance comes from Journal::recover(), not from the caller.
+    DurableBankAccount(int accountId, int recoveredBalance, Journal& j)
+        : id(accountId), balance(recoveredBalance), journal(j) {}
+
+    // The change is only reported as done AFTER it is safely on disk.
+    // A deposit is added to 'balance' only then, so a withdraw running at the
+    // same time cannot spend it: a failed deposit can never leave the account
+    // below zero. If the journal cannot store it, false is returned.
+    bool deposit(int amount) {
+        if (amount <= 0) {
+            return false;
+        }
+        if (!journal.commit(JournalRecord{id, amount})) {   // wait WITHOUT the account lock
+            return false;
+        }
+        lock_guard<mutex> guard(lock);
+        balance += amount;
+        return true;
+    }
+
+    bool withdraw(int amount) {
+        if (amount <= 0) {
+            return false;
+        }
+        uint64_t seq;
+        {
+            lock_guard<mutex> guard(lock);
+            if (amount > balance) {
+                return false;
+            }
+            seq = journal.append(JournalRecord{id, -amount});
+            balance -= amount;                // reserved at once: nobody else can spend it
+        }
+        if (!journal.waitDurable(seq)) {
+            lock_guard<mutex> guard(lock);
+            balance += amount;                // not saved: give the reservation back
+            return false;
+        }
+        return true;
+    }
+
+    int getBalance() {
+        lock_guard<mutex> guard(lock);
+        return balance;
+    }
+
+    // DESTRUCTOR
+    // The object is gone, but its history is in the journal.
+    ~DurableBankAccount() {
+        cout << "Account " << id << " closed. Final balance " << balance
+             << " is safe in the journal." << endl;
+    }
+};
+
+int main() {
+    const char* path = "bank.journal";
+    remove(path);
+
+    // ---------------------------------------------------------
+    // 1. First run: create an account and use it
+    // ---------------------------------------------------------
+    {
+        Journal journal(path);
+        DurableBankAccount account(1, 0, journal);
+        account.deposit(5000);
+        account.deposit(2000);
+        account.withdraw(1500);
+    } // destructor runs, memory is freed
+
+    // Simulate a crash in the middle of a write: half a record at the end.
+    {
+        FILE* f = fopen(path, "ab");
+        fwrite("\x08\x00\x00\x00garbage", 1, 11, f);
+        fclose(f);
+    }
+
+    // ---------------------------------------------------------
+    // 2. Restart: rebuild the balance from the journal
+    // ---------------------------------------------------------
+    {
+        map<int, int> balances = Journal::recover(path);
+        cout << "\nRecovered balance of account 1: " << balances[1] << " (expected 5500)" << endl;
+    }
+
+    // A journal that cannot be opened never reports a change as saved.
+    {
+        Journal broken("no-such-directory/bank.journal");
+        DurableBankAccount account(2, 0, broken);
+        bool saved = account.deposit(100);
+        cout << "Deposit with a broken journal: " << (saved ? "saved" : "refused")
+             << ", balance " << account.getBalance() << endl;
+    }
+
+    // ---------------------------------------------------------
+    // 3. BENCHMARK: more concurrent writers => bigger groups per fsync
+    // ---------------------------------------------------------
+    cout << "\n--- Group Commit Benchmark ---" << endl;
+    cout << "writers\tavg batch\tcommits/sec\tp99 latency (us)" << endl;
+
+    const int commitsPerWriter = 200;
+    for (int writers = 1; writers <= 64; writers *= 4) {
+        remove(path);
+        Journal journal(path);
+        vector<vector<double>> latencies(writers);
+        vector<thread> threads;
+
+        auto start = chrono::steady_clock::now();
+        for (int w = 0; w < writers; w++) {
+            threads.emplace_back([&journal, &latencies, w]() {
+                for (int i = 0; i < commitsPerWriter; i++) {
+                    auto t0 = chrono::steady_clock::now();
+                    journal.commit(JournalRecord{w, 1});
+                    chrono::duration<double, micro> us = chrono::steady_clock::now() - t0;
+                    latencies[w].push_back(us.count());
+                }
+            });
+        }
+        for (thread& t : threads) {
+            t.join();
+        }
+        chrono::duration<double> seconds = chrono::steady_clock::now() - start;
+
+        vector<double> all;
+        for (vector<double>& l : latencies) {
+            all.insert(all.end(), l.begin(), l.end());
+        }
+        sort(all.begin(), all.end());
+        double p99 = all[all.size() * 99 / 100];
+        double total = (double)writers * commitsPerWriter;
+
+        cout << writers << "\t" << total / journal.batchCount() << "\t\t"
+             << (long long)(total / seconds.count()) << "\t\t" << (long long)p99 << endl;
+    }
+    remove(path);
+
+    return 0;
+}
+
+//-------------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <utility>
+#include <fcntl.h>
+#include <unistd.h>
+using namespace std;
+
+/*
+    REAL-WORLD PROBLEM:
+    Every member function above prints with "cout << ... << endl".
+    'endl' FLUSHES the output, which is a system call on every line.
+    The printing costs far more than the deposit itself.
+
+    SOLUTION: an ASYNCHRONOUS LOGGER
+    - Each thread gets its own ring buffer. Logging only copies a format
+      string pointer and the numbers into it (no formatting, no lock).
+    - A background thread takes records out, formats them into one large
+      buffer, and writes that buffer with a single write() call.
+*/
+
+class AsyncLogger {
+private:
+    // One log line, NOT yet formatted.
+    // 'format' must be a string literal, e.g. "Deposited: %lld\n".
+    struct Record {
+        const char* format;
+        long long args[3];
+    };
+
+    // Single-producer / single-consumer ring buffer.
+    // Only the owning thread writes 'tail'; only the drain thread writes 'head'.
+    struct Ring {
+        static const size_t Capacity = 16384;          // must be a power of two
+        Record records[Capacity];
+        alignas(64) atomic<size_t> head{0};             // next record to read
+        alignas(64) atomic<size_t> tail{0};             // next free slot
+        atomic<bool> retired{false};                    // the owning thread has exited
+    };
+
+    // Every thread keeps its own list "logger id -> my ring in that logger".
+    // The list is thread_local, so its destructor runs when the thread exits:
+    // it retires the thread's rings, and each drainer frees its ring once
+    // the last records are written.
+    struct ThreadRings {
+        vector<pair<unsigned, shared_ptr<Ring>>> byLogger;
+
+        ~ThreadRings() {
+            for (auto& entry : byLogger) {
+                entry.second->retired.store(true, memory_order_release);
+            }
+        }
+    };
+
+    int fd;
+    const unsigned id;                  // tells this logger apart from older ones
+    atomic<bool> stopping;
+
+    mutex ringsLock;                    // drainer + a NEW thread logging for the first time
+                                        // (never on the fast path of log())
+    vector<shared_ptr<Ring>> rings;
+
+    thread drainer;
+
+    Ring& myRing() {
+        thread_local ThreadRings mine;
+        for (auto& entry : mine.byLogger) {
+            if (entry.first == id) {
+                return *entry.second;
+            }
+        }
+
+        // First log() of this thread on this logger. Also forget the rings of
+        // loggers that were destroyed: only this thread still holds them.
+        mine.byLogger.erase(remove_if(mine.byLogger.begin(), mine.byLogger.end(),
+                                      [](const pair<unsigned, shared_ptr<Ring>>& entry) {
+                                          return entry.second.use_count() == 1;
+                                      }),
+                            mine.byLogger.end());
+        shared_ptr<Ring> ring(new Ring());
+        {
+            lock_guard<mutex> guard(ringsLock);
+            rings.push_back(ring);
+        }
+        mine.byLogger.emplace_back(id, ring);
+        return *ring;
+    }
+
+    static unsigned nextId() {
+        static atomic<unsigned> counter(0);
+        return ++counter;
+    }
+
+    // Background thread: move records from every ring into 'out' and write
+    // it in big blocks.
+    void drainLoop() {
+        vector<char> out;
+        out.reserve(1 << 20);
+        char line[256];
+
+        while (true) {
+            bool stop = stopping.load(memory_order_acquire);
+            bool foundAny = false;
+            {
+                lock_guard<mutex> guard(ringsLock);
+                for (size_t i = 0; i < rings.size();) {
+                    Ring& ring = *rings[i];
+                    // Read 'retired' BEFORE 'tail': a retired thread logs
+                    // nothing more, so this drain empties its ring for good.
+                    bool retired = ring.retired.load(memory_order_acquire);
+                    size_t head = ring.head.load(memory_order_relaxed);
+                    size_t tail = ring.tail.load(memory_order_acquire);
+                    for (; head != tail; head++) {
+                        const Record& r = ring.records[head & (Ring::Capacity - 1)];
+                        int n = snprintf(line, sizeof(line), r.format, r.args[0], r.args[1], r.args[2]);
+                        if (n > 0) {
+                            out.insert(out.end(), line, line + min<size_t>(n, sizeof(line) - 1));
+                        }
+                        foundAny = true;
+                    }
+                    ring.head.store(head, memory_order_release);
+
+                    if (retired) {
+                        rings[i] = move(rings.back());   // free the ring of an exited thread
+                        rings.pop_back();
+                    } else {
+                        i++;
+                    }
+                }
+            }
+
+            if (out.size() >= (1 << 16) || (!foundAny && !out.empty())) {
+                flush(out);
+            }
+            if (stop && !foundAny) {
+                break;                       // everything logged before stop is written
+            }
+            if (!foundAny) {
+                this_thread::sleep_for(chrono::microseconds(200));
+            }
+        }
+        flush(out);
+    }
+
+    void flush(vector<char>& out) {
+        size_t written = 0;
+        while (written < out.size()) {
+            ssize_t n = write(fd, out.data() + written, out.size() - written);
+            if (n <= 0) {
+                break;
+            }
+            written += (size_t)n;
+        }
+        out.clear();
+    }
+
+public:
+    explicit AsyncLogger(int outputFd) : fd(outputFd), id(nextId()), stopping(false) {
+        drainer = thread(&AsyncLogger::drainLoop, this);
+    }
+
+    // Stops the background thread AFTER every record has been written.
+    ~AsyncLogger() {
+        stopping.store(true, memory_order_release);
+        drainer.join();
+    }
+
+    // Rings still owned by a running thread (for the demo)
+    size_t ringCount() {
+        lock_guard<mutex> guard(ringsLock);
+        return rings.size();
+    }
+
+    // Fast path: copy 4 words into this thread's ring. No formatting, no lock.
+    void log(const char* format, long long a = 0, long long b = 0, long long c = 0) {
+        Ring& ring = myRing();
+        size_t tail = ring.tail.load(memory_order_relaxed);
+        while (tail - ring.head.load(memory_order_acquire) == Ring::Capacity) {
+            this_thread::yield();            // ring is full: let the drainer catch up
+        }
+        Record& r = ring.records[tail & (Ring::Capacity - 1)];
+        r.format = format;
+        r.args[0] = a;
+        r.args[1] = b;
+        r.args[2] = c;
+        ring.tail.store(tail + 1, memory_order_release);
+    }
+};
+
+// The BankAccount from above, with every 'cout << ... << endl' replaced by the logger.
+class BankAccount {
+
+private:
+    int balance;
+    AsyncLogger& logger;
+
+public:
+    // CONSTRUCTOR
+    BankAccount(int initialBalance, AsyncLogger& l) : logger(l) {
+        balance = initialBalance;
+        logger.log("Account created with balance: %lld\n", balance);
+    }
+
+    void deposit(int amount) {
+        if (amount > 0) {
+            balance += amount;
+            logger.log("Deposited: %lld\n", amount);
+        }
+    }
+
+    void withdraw(int amount) {
+        if (amount <= balance) {
+            balance -= amount;
+            logger.log("Withdrawn: %lld\n", amount);
+        }
+    }
+
+    void showBalance() {
+        logger.log("Current balance: %lld\n", balance);
+    }
+
+    // DESTRUCTOR
+    ~BankAccount() {
+        logger.log("Account closed. Final balance was: %lld\n", balance);
+    }
+};
+
+// The same deposit loop, printed the old way (cout-style stream + endl).
+void depositLoopWithEndl(ostream& out, int count) {
+    int balance = 0;
+    for (int i = 0; i < count; i++) {
+        balance += 10;
+        out << "Deposited: " << 10 << endl;
+    }
+    out << "Current balance: " << balance << endl;
+}
+
+int main() {
+    // ---------------------------------------------------------
+    // 1. Same output as the cout version, written in the background
+    // ---------------------------------------------------------
+    {
+        AsyncLogger logger(STDOUT_FILENO);
+        BankAccount account(5000, logger);
+        account.deposit(2000);
+        account.withdraw(1500);
+        account.showBalance();
+    } // account destructor logs, THEN logger destructor writes everything
+
+    // Short-lived threads: each one gets a ring, which is freed when it exits.
+    // One thread switching between two loggers keeps one ring in each.
+    int demoFd = open("/dev/null", O_WRONLY);
+    {
+        AsyncLogger first(demoFd), second(demoFd);
+        for (int t = 0; t < 100; t++) {
+            thread([&first, &second, t]() {
+                for (int i = 0; i < 10; i++) {
+                    first.log("Worker %lld, first logger\n", t);
+                    second.log("Worker %lld, second logger\n", t);
+                }
+            }).join();
+        }
+        this_thread::sleep_for(chrono::milliseconds(10));   // let the drainers catch up
+        cout << "\nRings after 100 finished threads: " << first.ringCount()
+             << " + " << second.ringCount() << endl;
+    }
+    close(demoFd);
+
+    // ---------------------------------------------------------
+    // 2. BENCHMARK: deposit loop with endl vs. async logger
+    // ---------------------------------------------------------
+    const int deposits = 1000000;
+
+    ofstream devNull("/dev/null");
+    auto start = chrono::steady_clock::now();
+    depositLoopWithEndl(devNull, deposits);
+    chrono::duration<double, milli> withEndl = chrono::steady_clock::now() - start;
+
+    int nullFd = open("/dev/null", O_WRONLY);
+    chrono::duration<double, milli> callerTime, totalTime;
+    {
+        start = chrono::steady_clock::now();
+        AsyncLogger logger(nullFd);
+        {
+            BankAccount account(0, logger);
+            for (int i = 0; i < deposits; i++) {
+                account.deposit(10);
+            }
+        }
+        callerTime = chrono::steady_clock::now() - start;  // time the BUSINESS code waited
+    }
+    totalTime = chrono::steady_clock::now() - start;        // including the final drain
+    close(nullFd);
+
+    cout << "\n--- Benchmark: " << deposits << " deposits ---" << endl;
+    cout << "stream + endl:        " << withEndl.count() << " ms" << endl;
+    cout << "async logger (caller): " << callerTime.count() << " ms" << endl;
+    cout << "async logger (total):  " << totalTime.count() << " ms" << endl;
+
+    return 0;
+}
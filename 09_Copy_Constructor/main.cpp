@@ -126,4 +126,478 @@ int main() {
     // 3. No crash when destructors run.
     
     return 0;
-}
\ No newline at end of file
+}
+
+//-------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <new>
+#include <utility>
+using namespace std;
+
+/*
+    Deep is SAFE but every copy allocates and copies the whole payload.
+    Shallow is FAST (it only copies the address) but two objects share one
+    block, and the second destructor deletes it again.
+
+    COPY-ON-WRITE gives both:
+    - A copy shares the block, like Shallow, and adds 1 to a REFERENCE COUNT
+      stored in the block ("how many objects use me").
+    - The destructor subtracts 1. Only the LAST owner deletes the block, so
+      there is no double free.
+    - Reading is free. The first WRITE through a shared object first makes
+      its own private copy ("detach"), so the others never see the change.
+    - The count is an atomic<long>, so copies of one buffer can be created
+      and destroyed in different threads at the same time.
+*/
+
+class SharedBuffer {
+private:
+    // The block: the header, followed directly by the payload bytes
+    struct Header {
+        atomic<long> refs;
+        size_t size;
+    };
+
+    Header* block;
+
+    static Header* allocate(size_t size) {
+        Header* h = (Header*)::operator new(sizeof(Header) + size);
+        new (&h->refs) atomic<long>(1);
+        h->size = size;
+        liveBlocks.fetch_add(1, memory_order_relaxed);
+        return h;
+    }
+
+    static unsigned char* bytesOf(Header* h) {
+        return (unsigned char*)(h + 1);
+    }
+
+    void release() {
+        // acq_rel: the last owner must see every write the others made first
+        if (block && block->refs.fetch_sub(1, memory_order_acq_rel) == 1) {
+            block->refs.~atomic<long>();
+            ::operator delete(block);
+            liveBlocks.fetch_sub(1, memory_order_relaxed);
+        }
+    }
+
+public:
+    static atomic<long> liveBlocks;              // for the checks in main()
+
+    // 1. Normal Constructor
+    SharedBuffer(size_t size, unsigned char fill) : block(allocate(size)) {
+        memset(bytesOf(block), fill, size);
+    }
+
+    // 2. COPY CONSTRUCTOR: share the block (as cheap as Shallow)
+    SharedBuffer(const SharedBuffer& source) : block(source.block) {
+        if (block) {
+            block->refs.fetch_add(1, memory_order_relaxed);
+        }
+    }
+
+    // MOVE CONSTRUCTOR: take the block over, the count does not change.
+    // The source is left EMPTY (no block): size 0, used by 0, read() gives
+    // nullptr, and write() gives it a new, empty block.
+    SharedBuffer(SharedBuffer&& source) noexcept : block(source.block) {
+        source.block = nullptr;
+    }
+
+    // Copy and move assignment in one: 'other' is already a copy (or a moved value)
+    SharedBuffer& operator=(SharedBuffer other) noexcept {
+        swap(block, other.block);
+        return *this;
+    }
+
+    // 3. Destructor: only the last owner frees the memory
+    ~SharedBuffer() {
+        release();
+    }
+
+    size_t size() const { return block ? block->size : 0; }
+    long useCount() const { return block ? block->refs.load(memory_order_relaxed) : 0; }
+
+    // READ: never copies
+    const unsigned char* read() const {
+        return block ? bytesOf(block) : nullptr;
+    }
+
+    // WRITE: detach first if someone else still uses the block
+    unsigned char* write() {
+        if (!block) {
+            block = allocate(0);                  // a moved-from buffer gets its own empty block
+        } else if (block->refs.load(memory_order_acquire) != 1) {
+            Header* own = allocate(block->size);
+            memcpy(bytesOf(own), bytesOf(block), block->size);
+            release();
+            block = own;
+        }
+        return bytesOf(block);
+    }
+};
+
+atomic<long> SharedBuffer::liveBlocks{0};
+
+// The Deep idea for a buffer of any size: every copy gets its own memory.
+class DeepBuffer {
+private:
+    unsigned char* data;
+    size_t length;
+
+public:
+    DeepBuffer(size_t size, unsigned char fill) : data(new unsigned char[size]), length(size) {
+        memset(data, fill, size);
+    }
+
+    DeepBuffer(const DeepBuffer& source) : data(new unsigned char[source.length]), length(source.length) {
+        memcpy(data, source.data, length);
+    }
+
+    DeepBuffer& operator=(const DeepBuffer&) = delete;
+
+    ~DeepBuffer() {
+        delete[] data;
+    }
+
+    const unsigned char* read() const { return data; }
+    unsigned char* write() { return data; }
+};
+
+// Copy-heavy workload: every step copies the payload (like passing it by
+// value), reads one byte of the copy, and 1 copy in 100 is changed.
+template <typename Buffer>
+double nanosPerCopy(size_t size, long copies, long& checksum) {
+    Buffer original(size, 7);
+    auto start = chrono::steady_clock::now();
+    for (long i = 0; i < copies; i++) {
+        Buffer copy = original;
+        checksum += copy.read()[(size_t)i % size];
+        if (i % 100 == 0) {
+            copy.write()[(size_t)i % size] = (unsigned char)i;
+        }
+    }
+    chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+    checksum += original.read()[0];               // the original never changed
+    return elapsed.count() / copies;
+}
+
+int main() {
+    cout << "--- Creating Obj1 ---" << endl;
+    SharedBuffer obj1(1024, 10);
+    cout << "Obj1: value " << (int)obj1.read()[0] << ", used by " << obj1.useCount() << endl;
+
+    cout << "\n--- Creating Obj2 (Copy: shares the block) ---" << endl;
+    SharedBuffer obj2 = obj1;
+    cout << "Same address: " << (obj1.read() == obj2.read() ? "yes" : "no")
+         << ", used by " << obj1.useCount() << endl;
+
+    cout << "\n--- Writing to Obj2 (detaches first) ---" << endl;
+    obj2.write()[0] = 99;
+    cout << "Obj1: " << (int)obj1.read()[0] << " | Obj2: " << (int)obj2.read()[0]
+         << " | Same address: " << (obj1.read() == obj2.read() ? "yes" : "no") << endl;
+
+    cout << "\n--- Moving Obj2 into Obj3 ---" << endl;
+    SharedBuffer obj3 = move(obj2);
+    cout << "Obj3: value " << (int)obj3.read()[0] << ", size " << obj3.size() << endl;
+    cout << "Obj2 (moved from): size " << obj2.size() << ", used by " << obj2.useCount()
+         << ", read() " << (obj2.read() ? "has data" : "is nullptr") << endl;
+    SharedBuffer copyOfEmpty = obj2;              // copying an empty buffer is safe too
+    obj2.write();                                 // safe: obj2 gets a new empty block
+    cout << "Obj2 after write(): size " << obj2.size() << ", used by " << obj2.useCount() << endl;
+
+    // ---------------------------------------------------------
+    // THREAD-SAFETY CHECK: 8 threads copy one shared buffer and destroy the
+    // copies again, and every 10th copy is written to. At the end, the
+    // original must be unchanged, used by 1 object, and no block may leak.
+    // ---------------------------------------------------------
+    long blocksBefore = SharedBuffer::liveBlocks.load();
+    {
+        SharedBuffer shared(4096, 1);
+        vector<thread> workers;
+        atomic<long> wrongCopies{0};
+        for (int t = 0; t < 8; t++) {
+            workers.emplace_back([&shared, &wrongCopies, t]() {
+                for (int i = 0; i < 20000; i++) {
+                    SharedBuffer copy = shared;
+                    if (i % 10 == 0) {
+                        unsigned char* bytes = copy.write();
+                        bytes[i % 4096] = (unsigned char)(t + 2);
+                        if (copy.read()[i % 4096] != t + 2 || copy.read()[(i + 1) % 4096] != 1) {
+                            wrongCopies++;
+                        }
+                    } else if (copy.read()[i % 4096] != 1) {
+                        wrongCopies++;
+                    }
+                }
+            });
+        }
+        for (thread& w : workers) {
+            w.join();
+        }
+        bool untouched = true;
+        for (size_t i = 0; i < shared.size(); i++) untouched = untouched && shared.read()[i] == 1;
+        cout << "\n--- 8 threads, 160000 copies ---" << endl;
+        cout << "Wrong copies: " << wrongCopies.load() << " | Original unchanged: " << (untouched ? "yes" : "no")
+             << " | Used by: " << shared.useCount() << endl;
+    }
+    cout << "Leaked blocks: " << SharedBuffer::liveBlocks.load() - blocksBefore << endl;
+
+    // ---------------------------------------------------------
+    // BENCHMARK: copy-heavy workload, 1 KB to 1 MB payloads
+    // ---------------------------------------------------------
+    cout << "\n--- ns per copy (1 copy in 100 is changed) ---" << endl;
+    cout << "payload\t\tDeep copy\tcopy-on-write" << endl;
+    long checksum = 0;
+    for (size_t size = 1024; size <= (1 << 20); size *= 4) {
+        long copies = (long)((size_t)(1 << 30) / size);    // 1 GB of Deep copying per size
+        double deep = nanosPerCopy<DeepBuffer>(size, copies, checksum);
+        double cow = nanosPerCopy<SharedBuffer>(size, copies, checksum);
+        cout << size / 1024 << " KB\t\t" << deep << "\t\t" << cow << endl;
+    }
+    cout << "(checksum " << checksum << ")" << endl;
+
+    return 0;
+}
+
+
+//-------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+using namespace std;
+
+/*
+    Deep calls 'new int(val)' in its constructor and 'new int' again in its
+    copy constructor. Holding ONE integer costs a heap allocation, a delete,
+    and a jump to another memory location on every display().
+
+    SMALL-BUFFER OPTIMIZATION (SBO):
+    - The object contains a small array of its own (InlineCount items).
+    - Payloads that fit are stored INSIDE the object: no new, no delete.
+    - Only bigger payloads "spill" to the heap, exactly like Deep.
+    - The same array space holds the heap pointer when spilled (a union),
+      and 'count' tells which of the two is in use.
+    - Copy still makes an independent copy (Deep's safety). Move steals the
+      heap pointer, or copies the few inline items.
+*/
+
+template <typename T, size_t InlineCount>
+class SmallValue {
+    static_assert(is_trivially_copyable<T>::value, "items are copied with memcpy");
+
+private:
+    union {
+        T inlineItems[InlineCount];
+        T* heap;
+    };
+    size_t count;
+
+    bool isInline() const { return count <= InlineCount; }
+
+    // Gives this (empty) object room for n items
+    void reserveFor(size_t n) {
+        count = n;
+        if (!isInline()) {
+            heap = new T[n];
+        }
+    }
+
+public:
+    // 1. Normal Constructors
+    SmallValue(T val) : SmallValue(1, val) {}
+
+    SmallValue(size_t n, T fill) {
+        reserveFor(n);
+        T* items = data();
+        for (size_t i = 0; i < n; i++) {
+            items[i] = fill;
+        }
+    }
+
+    // 2. COPY CONSTRUCTOR: still a deep copy, but no 'new' for small payloads
+    SmallValue(const SmallValue& source) {
+        reserveFor(source.count);
+        memcpy(data(), source.data(), count * sizeof(T));
+    }
+
+    // MOVE CONSTRUCTOR: a spilled payload changes owner, an inline one is copied
+    SmallValue(SmallValue&& source) noexcept : count(source.count) {
+        if (isInline()) {
+            memcpy(inlineItems, source.inlineItems, count * sizeof(T));
+        } else {
+            heap = source.heap;
+            source.count = 0;                    // source is now empty (and inline)
+        }
+    }
+
+    SmallValue& operator=(const SmallValue& source) {
+        if (this != &source) {
+            SmallValue copy(source);
+            *this = move(copy);
+        }
+        return *this;
+    }
+
+    // MOVE ASSIGNMENT: free our own heap payload, then take over the source's
+    // the same way the move constructor does. Nothing here can throw.
+    SmallValue& operator=(SmallValue&& source) noexcept {
+        if (this != &source) {
+            if (!isInline()) {
+                delete[] heap;
+            }
+            count = source.count;
+            if (isInline()) {
+                memcpy(inlineItems, source.inlineItems, count * sizeof(T));
+            } else {
+                heap = source.heap;
+                source.count = 0;                // source is now empty (and inline)
+            }
+        }
+        return *this;
+    }
+
+    // 3. Destructor: only a spilled payload has anything to delete
+    ~SmallValue() {
+        if (!isInline()) {
+            delete[] heap;
+        }
+    }
+
+    size_t size() const { return count; }
+    T* data() { return isInline() ? inlineItems : heap; }
+    const T* data() const { return isInline() ? inlineItems : heap; }
+    T& operator[](size_t i) { return data()[i]; }
+    const T& operator[](size_t i) const { return data()[i]; }
+
+    void display() const {
+        if (count == 0) {
+            cout << "Value: (empty) | Items: 0" << endl;
+            return;
+        }
+        cout << "Value: " << data()[0] << " | Items: " << count << " | Address: " << data()
+             << (isInline() ? " (inside the object)" : " (heap)") << endl;
+    }
+};
+
+// Deep from above, for any number of ints: always on the heap
+class DeepValue {
+private:
+    int* data;
+    size_t count;
+
+public:
+    DeepValue(size_t n, int fill) : data(new int[n]), count(n) {
+        for (size_t i = 0; i < n; i++) data[i] = fill;
+    }
+
+    DeepValue(const DeepValue& source) : data(new int[source.count]), count(source.count) {
+        memcpy(data, source.data, count * sizeof(int));
+    }
+
+    DeepValue& operator=(const DeepValue&) = delete;
+
+    ~DeepValue() {
+        delete[] data;
+    }
+
+    int& operator[](size_t i) { return data[i]; }
+    int operator[](size_t i) const { return data[i]; }
+};
+
+typedef SmallValue<int, 16> SmallInts;         // up to 16 ints (64 bytes) inline
+
+// Construct one value of n items, copy it, destroy both
+template <typename Value>
+double lifecycleNanos(size_t n, int rounds, long& checksum) {
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        Value original(n, r);
+        Value copy(original);
+        checksum += copy[n - 1];
+    }
+    chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count() / rounds;
+}
+
+// ACCESS LATENCY: 1M values form one random cycle: the first item of each
+// value is the position of the next one. Every read must wait for the one
+// before, so the time per step is the full cost of reaching the payload.
+template <typename Value>
+double accessNanos(size_t n, const vector<int>& cycle, long& checksum) {
+    vector<Value> all;
+    all.reserve(cycle.size());
+    for (size_t i = 0; i < cycle.size(); i++) all.emplace_back(n, 0);
+    for (size_t i = 0; i < cycle.size(); i++) {
+        all[cycle[i]][0] = cycle[(i + 1) % cycle.size()];
+    }
+
+    int at = cycle[0];
+    auto start = chrono::steady_clock::now();
+    for (size_t step = 0; step < cycle.size(); step++) at = all[at][0];
+    chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+    checksum += at;
+    return elapsed.count() / cycle.size();
+}
+
+int main() {
+    cout << "--- Creating Obj1 (one int: stored inline) ---" << endl;
+    SmallInts obj1(10);
+    cout << "Obj1: "; obj1.display();
+
+    cout << "\n--- Creating Obj2 (Copy) ---" << endl;
+    SmallInts obj2 = obj1;
+    obj2[0] = 20;
+    cout << "Obj1: "; obj1.display();
+    cout << "Obj2: "; obj2.display();
+
+    cout << "\n--- A big payload (100 ints: spilled to the heap) ---" << endl;
+    SmallInts big(100, 7);
+    cout << "Big:   "; big.display();
+    SmallInts moved = move(big);
+    cout << "Moved: "; moved.display();
+    cout << "Big after the move: "; big.display();
+    big = SmallInts(3, 5);                      // move assignment into the moved-from value
+    cout << "Big reassigned:     "; big.display();
+    moved = move(moved);                        // self-move leaves the value unchanged
+    cout << "Moved after self-move: "; moved.display();
+
+    // ---------------------------------------------------------
+    // BENCHMARK: 16 ints fit inline; 17 and 64 spill to the heap
+    // ---------------------------------------------------------
+    const int rounds = 10000000;
+    long checksum = 0;
+    cout << "\n--- ns per construct + copy + destroy both ---" << endl;
+    cout << "ints\tDeep (heap)\tSBO" << endl;
+    for (size_t n : {1, 4, 16, 17, 64}) {
+        cout << n << "\t" << lifecycleNanos<DeepValue>(n, rounds, checksum)
+             << "\t\t" << lifecycleNanos<SmallInts>(n, rounds, checksum)
+             << (n <= 16 ? "\t(inline)" : "\t(spilled)") << endl;
+    }
+
+    vector<int> cycle(1000000);
+    for (size_t i = 0; i < cycle.size(); i++) cycle[i] = (int)i;
+    shuffle(cycle.begin(), cycle.end(), mt19937(21));
+
+    cout << "\n--- ns per dependent read, 1M values in random order ---" << endl;
+    cout << "ints\tDeep (heap)\tSBO" << endl;
+    for (size_t n : {1, 16, 17}) {
+        cout << n << "\t" << accessNanos<DeepValue>(n, cycle, checksum)
+             << "\t\t" << accessNanos<SmallInts>(n, cycle, checksum)
+             << (n <= 16 ? "\t(inline)" : "\t(spilled)") << endl;
+    }
+    cout << "(checksum " << checksum << ")" << endl;
+
+    return 0;
+}
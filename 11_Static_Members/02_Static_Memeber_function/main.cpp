@@ -0,0 +1,247 @@
+#include <iostream>
+using namespace std;
+
+class Student {
+private:
+    // static data member (shared by all objects)
+    static int noOfStudents;
+
+    // non-static data member (belongs to each object)
+    int rollNo;
+
+public:
+    // constructor
+    Student(int r) {
+        rollNo = r;
+        noOfStudents++;   // allowed: static member
+    }
+
+    // static member function
+    // can access ONLY static data members
+    static int getTotalStudents() {
+        return noOfStudents;
+
+        // return rollNo;   // ❌ ERROR:
+        // static function has no object,
+        // so non-static member cannot be accessed
+    }
+
+    // non-static member function
+    // can access both static and non-static members
+    int getRollNo() {
+        return rollNo;
+    }
+};
+
+// definition of static data member
+int Student::noOfStudents = 0;
+
+int main() {
+
+    Student s1(101);
+    Student s2(102);
+
+    // accessing static function using class name
+    int total = Student::getTotalStudents();
+    cout << "Total Students: " << total << endl;
+
+    // accessing non-static member requires an object
+    cout << "Roll No s1: " << s1.getRollNo() << endl;
+    cout << "Roll No s2: " << s2.getRollNo() << endl;
+
+    // ❌ ERROR example (as shown in slide)
+    // int x = Student::getRollNo();
+    // non-static member function cannot be called without object
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+using namespace std;
+
+/*
+    PROBLEM:
+    'noOfStudents++' in the constructor is NOT safe when many threads create
+    students at the same time: two threads can read the same old value and
+    one increment is lost. Making it 'atomic<int>' fixes the bug, but then
+    EVERY thread fights over the same cache line, and enrollment gets slower
+    the more threads you add.
+
+    SOLUTION: a RollNumberAllocator
+    - Roll numbers: each thread reserves a whole RANGE (e.g. 1024 numbers)
+      from one global atomic counter, then hands them out locally.
+      The shared counter is touched once per 1024 students.
+    - Counting: each thread adds to its OWN counter (a "shard", on its own
+      cache line). getTotalStudents() adds up all the shards.
+*/
+
+class RollNumberAllocator {
+private:
+    static const int RangeSize = 1024;
+    static const int ShardCount = 64;
+
+    struct alignas(64) Shard {
+        atomic<long long> count{0};
+    };
+
+    struct ThreadState {
+        int next = 0;            // next roll number this thread may hand out
+        int end = 0;             // end of the reserved range
+        Shard* shard = nullptr;
+    };
+
+    static atomic<int> nextRangeStart;
+    static atomic<int> nextShard;
+    static Shard shards[ShardCount];
+
+    static ThreadState& state() {
+        thread_local ThreadState s;
+        if (s.shard == nullptr) {
+            s.shard = &shards[nextShard.fetch_add(1, memory_order_relaxed) % ShardCount];
+        }
+        return s;
+    }
+
+public:
+    // Unique across all threads. Numbers are increasing inside one thread,
+    // but threads get different ranges, so they are not in global order.
+    static int allocate() {
+        ThreadState& s = state();
+        if (s.next == s.end) {
+            s.next = nextRangeStart.fetch_add(RangeSize, memory_order_relaxed);
+            s.end = s.next + RangeSize;
+        }
+        s.shard->count.fetch_add(1, memory_order_relaxed);   // (almost) never contended
+        return s.next++;
+    }
+
+    static long long total() {
+        long long sum = 0;
+        for (const Shard& shard : shards) {
+            sum += shard.count.load(memory_order_relaxed);
+        }
+        return sum;
+    }
+};
+
+atomic<int> RollNumberAllocator::nextRangeStart(1000);
+atomic<int> RollNumberAllocator::nextShard(0);
+RollNumberAllocator::Shard RollNumberAllocator::shards[RollNumberAllocator::ShardCount];
+
+class Student {
+private:
+    int rollNo;
+
+public:
+    // The constructor asks the allocator instead of doing 'noOfStudents++'
+    Student() {
+        rollNo = RollNumberAllocator::allocate();
+    }
+
+    // static member function: still cheap, still needs no object
+    static long long getTotalStudents() {
+        return RollNumberAllocator::total();
+    }
+
+    int getRollNo() const {
+        return rollNo;
+    }
+};
+
+// BASELINE: one shared atomic for the roll number and one for the count.
+class ContendedStudent {
+private:
+    static atomic<int> nextRollNo;
+    static atomic<long long> noOfStudents;
+    int rollNo;
+
+public:
+    ContendedStudent() {
+        rollNo = nextRollNo.fetch_add(1, memory_order_relaxed);
+        noOfStudents.fetch_add(1, memory_order_relaxed);
+    }
+
+    static long long getTotalStudents() {
+        return noOfStudents.load(memory_order_relaxed);
+    }
+
+    int getRollNo() const {
+        return rollNo;
+    }
+};
+
+atomic<int> ContendedStudent::nextRollNo(1000);
+atomic<long long> ContendedStudent::noOfStudents(0);
+
+// Every thread enrolls 'perThread' students; returns students per second.
+template <typename T>
+double enrollRate(int threads, int perThread) {
+    vector<thread> workers;
+    atomic<long long> checksum(0);             // uses every roll number, so no loop is skipped
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([perThread, &checksum]() {
+            long long sum = 0;
+            for (int i = 0; i < perThread; i++) {
+                T s;
+                sum += s.getRollNo();
+            }
+            checksum += sum;
+        });
+    }
+    for (thread& w : workers) {
+        w.join();
+    }
+    chrono::duration<double> seconds = chrono::steady_clock::now() - start;
+    return threads * (double)perThread / seconds.count();
+}
+
+int main() {
+    // ---------------------------------------------------------
+    // 1. Correctness: 8 threads, every roll number must be unique
+    // ---------------------------------------------------------
+    const int threads = 8, perThread = 50000;
+    vector<vector<int>> seen(threads);
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&seen, t]() {
+            for (int i = 0; i < perThread; i++) {
+                Student s;
+                seen[t].push_back(s.getRollNo());
+            }
+        });
+    }
+    for (thread& w : workers) {
+        w.join();
+    }
+    vector<int> all;
+    for (vector<int>& v : seen) {
+        all.insert(all.end(), v.begin(), v.end());
+    }
+    sort(all.begin(), all.end());
+    bool unique = adjacent_find(all.begin(), all.end()) == all.end();
+
+    cout << "Total Students: " << Student::getTotalStudents()
+         << " (expected " << threads * perThread << ")" << endl;
+    cout << "All roll numbers unique: " << (unique ? "yes" : "NO") << endl;
+
+    // ---------------------------------------------------------
+    // 2. BENCHMARK: enrollments per second, 1 to 64 threads
+    // ---------------------------------------------------------
+    cout << "\n--- Enrollment Benchmark (students/sec) ---" << endl;
+    cout << "threads\tshared atomic\tallocator" << endl;
+    for (int t = 1; t <= 64; t *= 2) {
+        int each = 4000000 / t;
+        cout << t << "\t" << (long long)enrollRate<ContendedStudent>(t, each)
+             << "\t" << (long long)enrollRate<Student>(t, each) << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,1299 @@
+#include <iostream>
+#include <string>
+using namespace std;
+
+class Book {
+private:
+    int id;
+    string title;
+
+public:
+    // 1. DEFAULT CONSTRUCTOR (Mandatory for Array declaration)
+    // The compiler needs this to create 'library[3]' initially.
+    Book() {
+        id = 0;
+        title = "Untitled";
+    }
+
+    // 2. PARAMETERIZED CONSTRUCTOR
+    // Used if we want to set data manually later
+    Book(int i, string t) {
+        id = i;
+        title = t;
+    }
+
+    // Helper function to set data
+    void setData(int i, string t) {
+        id = i;
+        title = t;
+    }
+
+    void display() const {
+        cout << "Book ID: " << id << " | Title: " << title << endl;
+    }
+};
+
+int main() {
+    // ---------------------------------------------------------
+    // STEP 1: Creating Array of Objects
+    // ---------------------------------------------------------
+    // This line creates 3 objects.
+    // The 'Default Constructor' is called 3 times here.
+    Book library[3]; 
+
+    // ---------------------------------------------------------
+    // STEP 2: Initializing the Objects
+    // ---------------------------------------------------------
+    // We access them using index [0], [1], [2] just like int arrays.
+    
+    library[0].setData(101, "C++ Programming");
+    library[1].setData(102, "Database Systems");
+    library[2].setData(103, "Data Structures");
+
+    // ---------------------------------------------------------
+    // STEP 3: Displaying via Loop
+    // ---------------------------------------------------------
+    cout << "--- Library Collection ---" << endl;
+    
+    for (int i = 0; i < 3; i++) {
+        // Accessing member function for each object
+        library[i].display();
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+/*
+    PROBLEM:
+    With 'Book library[3]' (or Student students[N]) the only way to find an
+    object by its number is a loop over the whole array. With millions of
+    records that is far too slow.
+
+    SOLUTION: a HASH INDEX  rollNo -> position in the array
+    - Open addressing: everything lives in flat arrays, no linked nodes.
+    - Every slot has a 1-byte "control" value: EMPTY, or 7 bits of the hash.
+      With SSE2, 16 control bytes are compared in ONE instruction, so most
+      wrong slots are skipped without even looking at the keys.
+    - Erase uses "backward shift": later entries are moved back into the
+      hole, so no "deleted" markers (tombstones) pile up and slow lookups down.
+*/
+
+class Student {
+public:
+    int rollNo;
+    float cgpa;
+};
+
+class RollNoIndex {
+private:
+    static constexpr uint8_t Empty = 0x80;    // high bit set = empty; tags use 0..127
+    static constexpr size_t Group = 16;
+
+    vector<uint8_t> ctrl;      // capacity + 16 bytes: the first 16 are copied at the end,
+                               // so a 16-byte load near the end does not need to wrap around
+    struct Entry {
+        int rollNo;
+        uint32_t slot;         // position of the Student in the records array
+    };
+    vector<Entry> entries;     // key and value side by side: one cache miss, not two
+    size_t capacity;           // always a power of two
+    size_t count;
+
+    static uint64_t hashOf(int rollNo) {
+        uint64_t h = (uint64_t)(uint32_t)rollNo * 0x9E3779B97F4A7C15ull;
+        return h ^ (h >> 29);
+    }
+
+    size_t homeOf(uint64_t h) const { return (size_t)(h >> 7) & (capacity - 1); }
+    static uint8_t tagOf(uint64_t h) { return (uint8_t)(h & 0x7F); }
+
+    void setCtrl(size_t i, uint8_t value) {
+        ctrl[i] = value;
+        if (i < Group) {
+            ctrl[capacity + i] = value;        // keep the mirrored copy in sync
+        }
+    }
+
+    // Bit k is set if ctrl[i + k] == value, for the 16 slots starting at i.
+    uint32_t match(size_t i, uint8_t value) const {
+#if defined(__SSE2__)
+        __m128i group = _mm_loadu_si128((const __m128i*)&ctrl[i]);
+        return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)value)));
+#else
+        uint32_t mask = 0;
+        for (size_t k = 0; k < Group; k++) {
+            mask |= (uint32_t)(ctrl[i + k] == value) << k;
+        }
+        return mask;
+#endif
+    }
+
+    // Returns the slot holding rollNo, or 'capacity' if it is not there.
+    size_t locate(int rollNo) const {
+        uint64_t h = hashOf(rollNo);
+        uint8_t tag = tagOf(h);
+        size_t i = homeOf(h);
+        while (true) {
+            uint32_t candidates = match(i, tag);
+            uint32_t empties = match(i, Empty);
+            // Only slots BEFORE the first empty one can hold our key.
+            uint32_t limit = empties ? (empties & (0u - empties)) - 1 : 0xFFFFu;
+            candidates &= limit;
+            while (candidates) {
+                size_t k = (size_t)__builtin_ctz(candidates);
+                size_t slot = (i + k) & (capacity - 1);
+                if (entries[slot].rollNo == rollNo) {
+                    return slot;
+                }
+                candidates &= candidates - 1;
+            }
+            if (empties) {
+                return capacity;
+            }
+            i = (i + Group) & (capacity - 1);
+        }
+    }
+
+    void rehash(size_t newCapacity) {
+        vector<uint8_t> oldCtrl;
+        vector<Entry> oldEntries;
+        oldCtrl.swap(ctrl);
+        oldEntries.swap(entries);
+        size_t oldCapacity = capacity;
+
+        capacity = newCapacity;
+        count = 0;
+        ctrl.assign(capacity + Group, Empty);
+        entries.resize(capacity);
+        for (size_t i = 0; i < oldCapacity; i++) {
+            if (oldCtrl[i] != Empty) {
+                insert(oldEntries[i].rollNo, oldEntries[i].slot);
+            }
+        }
+    }
+
+public:
+    RollNoIndex() : capacity(0), count(0) {
+        rehash(Group);
+    }
+
+    // Adds (or updates) rollNo -> slot.
+    void insert(int rollNo, uint32_t slot) {
+        if ((count + 1) * 4 > capacity * 3) {
+            rehash(capacity * 2);              // keep at most 75% full
+        }
+        size_t found = locate(rollNo);
+        if (found != capacity) {
+            entries[found].slot = slot;
+            return;
+        }
+        uint64_t h = hashOf(rollNo);
+        size_t i = homeOf(h);
+        while (ctrl[i] != Empty) {             // linear probing to the first empty slot
+            i = (i + 1) & (capacity - 1);
+        }
+        setCtrl(i, tagOf(h));
+        entries[i] = Entry{rollNo, slot};
+        count++;
+    }
+
+    // Returns true and sets 'slot' if rollNo is in the index.
+    bool find(int rollNo, uint32_t& slot) const {
+        size_t i = locate(rollNo);
+        if (i == capacity) {
+            return false;
+        }
+        slot = entries[i].slot;
+        return true;
+    }
+
+    // BACKWARD-SHIFT DELETION (no tombstones):
+    // after emptying slot 'hole', walk forward; every entry that would still
+    // be found from its home slot if it sat in the hole is moved back.
+    bool erase(int rollNo) {
+        size_t hole = locate(rollNo);
+        if (hole == capacity) {
+            return false;
+        }
+        size_t j = hole;
+        while (true) {
+            j = (j + 1) & (capacity - 1);
+            if (ctrl[j] == Empty) {
+                break;
+            }
+            size_t home = homeOf(hashOf(entries[j].rollNo));
+            // Can the entry at j move to 'hole'? Only if its home is NOT
+            // in the cyclic range (hole, j].
+            bool homeBetween = hole <= j ? (hole < home && home <= j)
+                                         : (hole < home || home <= j);
+            if (!homeBetween) {
+                setCtrl(hole, ctrl[j]);
+                entries[hole] = entries[j];
+                hole = j;
+            }
+        }
+        setCtrl(hole, Empty);
+        count--;
+        return true;
+    }
+
+    size_t size() const {
+        return count;
+    }
+};
+
+template <typename Fn>
+double nanosPerOp(size_t ops, Fn fn) {
+    auto start = chrono::steady_clock::now();
+    fn();
+    chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+    return elapsed.count() / ops;
+}
+
+void benchmark(size_t n) {
+    // Distinct, shuffled roll numbers
+    vector<int> rollNos(n);
+    for (size_t i = 0; i < n; i++) rollNos[i] = (int)(i * 2 + 1000);
+    mt19937 rng(11);
+    shuffle(rollNos.begin(), rollNos.end(), rng);
+
+    vector<Student> records(n);
+    for (size_t i = 0; i < n; i++) records[i] = Student{rollNos[i], 2.0f + (i % 20) / 10.0f};
+
+    vector<int> queries(rollNos);
+    shuffle(queries.begin(), queries.end(), rng);
+    float checksum = 0;
+
+    RollNoIndex index;
+    double flatInsert = nanosPerOp(n, [&]() {
+        for (size_t i = 0; i < n; i++) index.insert(records[i].rollNo, (uint32_t)i);
+    });
+    double flatLookup = nanosPerOp(n, [&]() {
+        uint32_t slot;
+        for (int r : queries) if (index.find(r, slot)) checksum += records[slot].cgpa;
+    });
+    double flatErase = nanosPerOp(n / 2, [&]() {
+        for (size_t i = 0; i < n / 2; i++) index.erase(queries[i]);
+    });
+
+    unordered_map<int, Student> map;
+    double stdInsert = nanosPerOp(n, [&]() {
+        for (size_t i = 0; i < n; i++) map.emplace(records[i].rollNo, records[i]);
+    });
+    double stdLookup = nanosPerOp(n, [&]() {
+        for (int r : queries) {
+            auto it = map.find(r);
+            if (it != map.end()) checksum += it->second.cgpa;
+        }
+    });
+    double stdErase = nanosPerOp(n / 2, [&]() {
+        for (size_t i = 0; i < n / 2; i++) map.erase(queries[i]);
+    });
+
+    cout << n << " keys (ns/op)\tinsert\tlookup\terase" << endl;
+    cout << "  RollNoIndex\t\t" << flatInsert << "\t" << flatLookup << "\t" << flatErase << endl;
+    cout << "  unordered_map\t\t" << stdInsert << "\t" << stdLookup << "\t" << stdErase << endl;
+    cout << "  (checksum " << checksum << ", left after erase: " << index.size()
+         << " / " << map.size() << ")" << endl;
+}
+
+int main(int argc, char* argv[]) {
+    // Small example: find a student by roll number without a loop
+    Student students[3] = {{101, 3.7f}, {205, 3.1f}, {309, 3.9f}};
+    RollNoIndex index;
+    for (uint32_t i = 0; i < 3; i++) {
+        index.insert(students[i].rollNo, i);
+    }
+
+    uint32_t slot;
+    if (index.find(205, slot)) {
+        cout << "Roll No 205 -> CGPA " << students[slot].cgpa << endl;
+    }
+    index.erase(205);
+    cout << "After erase, 205 found? " << (index.find(205, slot) ? "yes" : "no") << endl;
+
+    // ---------------------------------------------------------
+    // BENCHMARK: 1M keys (run with --large for 50M, needs ~5 GB of RAM)
+    // ---------------------------------------------------------
+    cout << "\n--- Benchmark ---" << endl;
+    benchmark(1000000);
+    if (argc > 1 && string(argv[1]) == "--large") {
+        benchmark(50000000);
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+using namespace std;
+
+/*
+    PROBLEM:
+    Every example builds its objects by hand in main(). A real program loads
+    them from a file, and parsing millions of text lines ("101,3.7,Ali")
+    on every start-up is slow.
+
+    SOLUTION: a BINARY ROSTER FILE that can be used IN PLACE
+    - The file layout is fixed, so after mmap() the numbers in the file ARE
+      the data. Nothing is parsed, nothing is copied into objects.
+    - Layout (all little-endian, every section 8-byte aligned):
+
+        [Header 64 bytes]
+        [rollNo  column : int32   x count]
+        [cgpa    column : float   x count]
+        [name offsets   : uint64  x (count + 1)]   name i = heap[off[i] .. off[i+1])
+        [string heap    : chars]
+    - Offsets are 64-bit, so the string heap may be larger than 4 GB.
+*/
+
+struct RosterHeader {
+    char magic[8];               // "ROSTER\0\0"
+    uint32_t version;            // bump when the layout changes
+    uint32_t headerSize;         // sizeof(RosterHeader), for sanity checks
+    uint64_t count;              // number of students
+    uint64_t rollNoOffset;       // where each section starts (bytes from file start)
+    uint64_t cgpaOffset;
+    uint64_t nameOffsetsOffset;
+    uint64_t heapOffset;
+    uint64_t heapSize;
+};
+
+static_assert(sizeof(RosterHeader) == 64, "header layout must not change");
+
+const uint32_t RosterVersion = 2;       // 2: 64-bit name offsets and heap size
+
+struct StudentRecord {
+    int rollNo;
+    float cgpa;
+    string name;
+};
+
+static uint64_t align8(uint64_t x) {
+    return (x + 7) & ~uint64_t(7);
+}
+
+// Writes n items, item(0) ... item(n - 1), through a small buffer on the
+// stack, so a multi-GB roster never has to exist in memory a second time.
+template <typename T, typename Item>
+static bool writeSection(FILE* f, uint64_t n, Item item) {
+    const size_t ChunkItems = 8192;
+    T chunk[ChunkItems];
+    uint64_t i = 0;
+    while (i < n) {
+        size_t k = 0;
+        for (; k < ChunkItems && i < n; k++, i++) {
+            chunk[k] = item(i);
+        }
+        if (fwrite(chunk, sizeof(T), k, f) != k) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Zero bytes from the current file position up to 'offset'
+static bool padTo(FILE* f, uint64_t written, uint64_t offset) {
+    static const char zeros[8] = {};
+    return fwrite(zeros, 1, offset - written, f) == offset - written;
+}
+
+// WRITER: computes the layout, then STREAMS every section to the file.
+bool writeRoster(const char* path, const vector<StudentRecord>& students) {
+    uint64_t n = students.size();
+    RosterHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, "ROSTER\0\0", 8);
+    h.version = RosterVersion;
+    h.headerSize = sizeof(RosterHeader);
+    h.count = n;
+    h.rollNoOffset = sizeof(RosterHeader);
+    h.cgpaOffset = align8(h.rollNoOffset + n * sizeof(int32_t));
+    h.nameOffsetsOffset = align8(h.cgpaOffset + n * sizeof(float));
+    h.heapOffset = align8(h.nameOffsetsOffset + (n + 1) * sizeof(uint64_t));
+    h.heapSize = 0;
+    for (const StudentRecord& s : students) {
+        h.heapSize += s.name.size();
+    }
+
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        return false;
+    }
+    uint64_t at = 0;                              // next name offset
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1 &&
+              writeSection<int32_t>(f, n, [&](uint64_t i) { return (int32_t)students[i].rollNo; }) &&
+              padTo(f, h.rollNoOffset + n * sizeof(int32_t), h.cgpaOffset) &&
+              writeSection<float>(f, n, [&](uint64_t i) { return students[i].cgpa; }) &&
+              padTo(f, h.cgpaOffset + n * sizeof(float), h.nameOffsetsOffset) &&
+              writeSection<uint64_t>(f, n + 1, [&](uint64_t i) {
+                  uint64_t here = at;
+                  if (i < n) at += students[i].name.size();
+                  return here;
+              }) &&
+              padTo(f, h.nameOffsetsOffset + (n + 1) * sizeof(uint64_t), h.heapOffset);
+    for (uint64_t i = 0; ok && i < n; i++) {
+        const string& name = students[i].name;
+        ok = fwrite(name.data(), 1, name.size(), f) == name.size();
+    }
+    return fclose(f) == 0 && ok;
+}
+
+// Writes the file's dirty pages to disk and asks the kernel to drop them
+// from its page cache, so the next read really comes from the disk.
+// (Advice only: the kernel may keep some pages anyway.)
+void dropFromPageCache(const char* path) {
+    int fd = ::open(path, O_RDONLY);
+    if (fd >= 0) {
+        fdatasync(fd);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+}
+
+// VALIDATOR: checks every offset BEFORE anything is read through it,
+// so a damaged or truncated file can never make us read outside the mapping.
+bool validateRoster(const char* data, uint64_t size, string& error) {
+    if (size < sizeof(RosterHeader)) {
+        error = "file is smaller than the header";
+        return false;
+    }
+    RosterHeader h;
+    memcpy(&h, data, sizeof(h));
+    if (memcmp(h.magic, "ROSTER\0\0", 8) != 0) {
+        error = "not a roster file (bad magic)";
+        return false;
+    }
+    if (h.version != RosterVersion || h.headerSize != sizeof(RosterHeader)) {
+        error = "unsupported roster version";
+        return false;
+    }
+    uint64_t n = h.count;
+    if (n > size / sizeof(int32_t)) {
+        error = "record count larger than the file";
+        return false;
+    }
+    bool layoutOk = h.rollNoOffset == sizeof(RosterHeader) &&
+                    h.cgpaOffset == align8(h.rollNoOffset + n * sizeof(int32_t)) &&
+                    h.nameOffsetsOffset == align8(h.cgpaOffset + n * sizeof(float)) &&
+                    h.heapOffset == align8(h.nameOffsetsOffset + (n + 1) * sizeof(uint64_t)) &&
+                    h.heapOffset <= size && h.heapSize <= size - h.heapOffset;
+    if (!layoutOk) {
+        error = "section offsets are out of bounds";
+        return false;
+    }
+    const uint64_t* offsets = (const uint64_t*)(data + h.nameOffsetsOffset);
+    if (offsets[0] != 0 || offsets[n] != h.heapSize) {
+        error = "name offsets do not cover the string heap";
+        return false;
+    }
+    for (uint64_t i = 0; i < n; i++) {
+        if (offsets[i] > offsets[i + 1]) {
+            error = "name offsets are not increasing";
+            return false;
+        }
+    }
+    return true;
+}
+
+// READER: maps the file and answers questions directly from it.
+class MappedRoster {
+private:
+    const char* data;
+    uint64_t size;
+    RosterHeader header;
+    string error;
+
+public:
+    MappedRoster() : data(nullptr), size(0) {}
+
+    ~MappedRoster() {
+        if (data) {
+            munmap((void*)data, size);
+        }
+    }
+
+    MappedRoster(const MappedRoster&) = delete;
+    MappedRoster& operator=(const MappedRoster&) = delete;
+
+    bool open(const char* path) {
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) {
+            error = "cannot open file";
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size == 0) {
+            close(fd);
+            error = "cannot read file size";
+            return false;
+        }
+        size = (uint64_t)st.st_size;
+        void* p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);                                    // the mapping stays valid
+        if (p == MAP_FAILED) {
+            error = "mmap failed";
+            return false;
+        }
+        data = (const char*)p;
+        if (!validateRoster(data, size, error)) {
+            return false;
+        }
+        memcpy(&header, data, sizeof(header));
+        return true;
+    }
+
+    const string& lastError() const { return error; }
+
+    uint64_t count() const { return header.count; }
+
+    int rollNo(uint64_t i) const {
+        return ((const int32_t*)(data + header.rollNoOffset))[i];
+    }
+
+    float cgpa(uint64_t i) const {
+        return ((const float*)(data + header.cgpaOffset))[i];
+    }
+
+    const float* cgpaColumn() const {
+        return (const float*)(data + header.cgpaOffset);
+    }
+
+    string_view name(uint64_t i) const {
+        const uint64_t* off = (const uint64_t*)(data + header.nameOffsetsOffset);
+        return string_view(data + header.heapOffset + off[i], off[i + 1] - off[i]);
+    }
+};
+
+int main() {
+    const char* binPath = "roster.bin";
+    const char* csvPath = "roster.csv";
+    const int students = 5000000;
+
+    // ---------------------------------------------------------
+    // 1. Write the same roster as CSV and as a binary roster file
+    // ---------------------------------------------------------
+    {
+        vector<StudentRecord> roster;
+        roster.reserve(students);
+        for (int i = 0; i < students; i++) {
+            roster.push_back(StudentRecord{100 + i, 2.0f + (i % 21) / 10.0f, "Student " + to_string(i)});
+        }
+        if (!writeRoster(binPath, roster)) {
+            cout << "Could not write " << binPath << endl;
+            return 1;
+        }
+        ofstream csv(csvPath);
+        for (const StudentRecord& s : roster) {
+            csv << s.rollNo << ',' << s.cgpa << ',' << s.name << '\n';
+        }
+    }
+    // A real start-up finds the files on disk, not in memory.
+    dropFromPageCache(csvPath);
+    dropFromPageCache(binPath);
+
+    // ---------------------------------------------------------
+    // 2. Start-up A: parse the CSV into objects, then answer a query
+    // ---------------------------------------------------------
+    auto start = chrono::steady_clock::now();
+    double csvAverage = 0;
+    {
+        vector<StudentRecord> parsed;
+        ifstream in(csvPath);
+        string line;
+        while (getline(in, line)) {
+            stringstream fields(line);
+            StudentRecord s;
+            string part;
+            getline(fields, part, ',');
+            s.rollNo = stoi(part);
+            getline(fields, part, ',');
+            s.cgpa = stof(part);
+            getline(fields, s.name);
+            parsed.push_back(s);
+        }
+        for (const StudentRecord& s : parsed) csvAverage += s.cgpa;
+        csvAverage /= parsed.size();
+    }
+    chrono::duration<double, milli> csvTime = chrono::steady_clock::now() - start;
+
+    // ---------------------------------------------------------
+    // 3. Start-up B: map the binary file, validate it, answer the same query
+    // ---------------------------------------------------------
+    start = chrono::steady_clock::now();
+    double binAverage = 0;
+    MappedRoster roster;
+    if (!roster.open(binPath)) {
+        cout << "Invalid roster: " << roster.lastError() << endl;
+        return 1;
+    }
+    const float* cgpa = roster.cgpaColumn();
+    for (uint64_t i = 0; i < roster.count(); i++) binAverage += cgpa[i];
+    binAverage /= roster.count();
+    chrono::duration<double, milli> binTime = chrono::steady_clock::now() - start;
+
+    cout << "Student #42: " << roster.rollNo(42) << ", " << roster.name(42)
+         << ", CGPA " << roster.cgpa(42) << endl;
+
+    cout << "\n--- Start-up with " << students << " students (page cache dropped first) ---" << endl;
+    cout << "CSV parse:     " << csvTime.count() << " ms (average CGPA " << csvAverage << ")" << endl;
+    cout << "mmap + verify: " << binTime.count() << " ms (average CGPA " << binAverage << ")" << endl;
+
+    // A damaged file is rejected by the validator instead of crashing the reader.
+    {
+        FILE* f = fopen(binPath, "r+b");
+        uint64_t hugeCount = 1ull << 40;
+        fseek(f, 16, SEEK_SET);                       // 'count' field
+        fwrite(&hugeCount, sizeof(hugeCount), 1, f);
+        fclose(f);
+        MappedRoster broken;
+        if (!broken.open(binPath)) {
+            cout << "\nDamaged file rejected: " << broken.lastError() << endl;
+        }
+    }
+
+    remove(binPath);
+    remove(csvPath);
+    return 0;
+}
+
+//-----------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <utility>
+#include <sys/wait.h>
+#include <unistd.h>
+using namespace std;
+
+/*
+    PROBLEM:
+    'Book library[3]' needs a DEFAULT constructor, and then every element is
+    overwritten with setData(). Each Book is built twice: once as "Untitled",
+    once with its real data. For a catalog of tens of millions of books loaded
+    from a file, that is millions of wasted constructions, and the array size
+    must be known before the file is read.
+
+    SOLUTION: a BookCatalog with UNINITIALIZED storage
+    - Memory is reserved as raw bytes (no constructor runs).
+    - emplace(id, title) builds the Book directly in its place with
+      "placement new": exactly ONE constructor per book, and Book does not
+      need a default constructor at all.
+    - Storage grows in fixed blocks of 65536 books. Old blocks are never
+      moved, so there is no moment where the old and new array both exist.
+    - A streaming CSV loader reads the file in 1 MB chunks and emplaces each
+      book as soon as its line is parsed.
+*/
+
+class Book {
+private:
+    int id;
+    string title;
+
+public:
+    // --- STATIC DATA MEMBERS: count constructor calls across all books ---
+    static long defaultBuilt;
+    static long dataBuilt;
+
+    Book() : id(0), title("Untitled") {
+        defaultBuilt++;
+    }
+
+    Book(int i, string t) : id(i), title(move(t)) {
+        dataBuilt++;
+    }
+
+    void setData(int i, string t) {
+        id = i;
+        title = move(t);
+    }
+
+    int getId() const { return id; }
+    const string& getTitle() const { return title; }
+
+    void display() const {
+        cout << "Book ID: " << id << " | Title: " << title << endl;
+    }
+};
+
+long Book::defaultBuilt = 0;
+long Book::dataBuilt = 0;
+
+class BookCatalog {
+private:
+    static const size_t BlockShift = 16;
+    static const size_t BlockBooks = size_t(1) << BlockShift;   // 65536 books per block
+
+    vector<Book*> blocks;        // raw memory, only the first 'count' slots hold a Book
+    size_t count;
+
+public:
+    BookCatalog() : count(0) {}
+    BookCatalog(const BookCatalog&) = delete;
+    BookCatalog& operator=(const BookCatalog&) = delete;
+
+    ~BookCatalog() {
+        for (size_t i = 0; i < count; i++) {
+            (*this)[i].~Book();                   // placement new needs a manual destructor call
+        }
+        for (Book* block : blocks) {
+            ::operator delete(block);
+        }
+    }
+
+    // Builds the Book in place: no default constructor, no copy, no setData()
+    template <typename... Args>
+    Book& emplace(Args&&... args) {
+        if (count == blocks.size() * BlockBooks) {
+            blocks.push_back((Book*)::operator new(BlockBooks * sizeof(Book)));
+        }
+        Book* slot = blocks[count >> BlockShift] + (count & (BlockBooks - 1));
+        new (slot) Book(forward<Args>(args)...);
+        count++;
+        return *slot;
+    }
+
+    Book& operator[](size_t i) { return blocks[i >> BlockShift][i & (BlockBooks - 1)]; }
+    const Book& operator[](size_t i) const { return blocks[i >> BlockShift][i & (BlockBooks - 1)]; }
+    size_t size() const { return count; }
+};
+
+// Parses one "id,title" line. Returns false for a malformed line.
+bool parseBookLine(const char* line, const char* end, int& id, const char*& title) {
+    if (end > line && end[-1] == '\r') {
+        end--;
+    }
+    id = 0;
+    const char* p = line;
+    while (p < end && *p >= '0' && *p <= '9') {
+        id = id * 10 + (*p - '0');
+        p++;
+    }
+    if (p == line || p == end || *p != ',') {
+        return false;
+    }
+    title = p + 1;
+    return true;
+}
+
+// STREAMING LOADER: reads 1 MB at a time and emplaces every complete line.
+// A line cut at the end of a chunk is moved to the front and finished with
+// the next chunk. Returns the number of malformed lines that were skipped.
+size_t loadCatalog(const char* path, BookCatalog& catalog) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        return 0;
+    }
+    vector<char> buffer(1 << 20);
+    size_t kept = 0;
+    size_t skipped = 0;
+    while (true) {
+        size_t got = fread(buffer.data() + kept, 1, buffer.size() - kept, file);
+        size_t filled = kept + got;
+        bool lastChunk = got == 0;
+        if (filled == 0) {
+            break;
+        }
+
+        const char* start = buffer.data();
+        const char* stop = start + filled;
+        while (start < stop) {
+            const char* newline = (const char*)memchr(start, '\n', stop - start);
+            if (!newline && !lastChunk) {
+                break;                            // incomplete line: wait for the next chunk
+            }
+            const char* end = newline ? newline : stop;
+            int id;
+            const char* title;
+            if (parseBookLine(start, end, id, title)) {
+                size_t length = (size_t)(end - title) - (end[-1] == '\r');
+                catalog.emplace(id, string(title, length));
+            } else if (end > start) {
+                skipped++;
+            }
+            start = end + 1;
+        }
+        if (lastChunk) {
+            break;
+        }
+
+        kept = start < stop ? (size_t)(stop - start) : 0;
+        memmove(buffer.data(), start, kept);
+        if (kept == buffer.size()) {
+            buffer.resize(buffer.size() * 2);    // a line longer than the whole buffer
+        }
+    }
+    fclose(file);
+    return skipped;
+}
+
+// BEFORE: the chapter's approach. Count the lines, create the array (one
+// default constructor per book), then read again and call setData().
+Book* loadArray(const char* path, size_t& n) {
+    ifstream in(path);
+    string line;
+    n = 0;
+    while (getline(in, line)) n++;
+
+    Book* library = new Book[n];
+    in.clear();
+    in.seekg(0);
+    size_t i = 0;
+    while (getline(in, line)) {
+        size_t comma = line.find(',');
+        library[i++].setData(stoi(line.substr(0, comma)), line.substr(comma + 1));
+    }
+    return library;
+}
+
+// Peak resident memory of this process in MB (Linux: VmHWM in /proc/self/status)
+long peakMB() {
+    ifstream status("/proc/self/status");
+    string key;
+    long kB = 0;
+    while (status >> key) {
+        if (key == "VmHWM:") {
+            status >> kB;
+            break;
+        }
+        status.ignore(1000, '\n');
+    }
+    return kB / 1024;
+}
+
+// Runs one loader in a child process, so each one gets its own peak memory.
+template <typename Loader>
+void measure(const char* label, Loader load) {
+    cout << flush;
+    pid_t child = fork();
+    if (child == 0) {
+        Book::defaultBuilt = 0;
+        Book::dataBuilt = 0;
+        auto start = chrono::steady_clock::now();
+        size_t books = load();
+        chrono::duration<double> seconds = chrono::steady_clock::now() - start;
+        cout << label << seconds.count() << "\t\t" << peakMB() << "\t\t"
+             << Book::defaultBuilt << " + " << Book::dataBuilt << "\t(" << books << " books)" << endl;
+        _exit(0);
+    }
+    waitpid(child, nullptr, 0);
+}
+
+int main(int argc, char* argv[]) {
+    BookCatalog small;
+    small.emplace(101, "C++ Programming");
+    small.emplace(102, "Database Systems");
+    small.emplace(103, "Data Structures");
+    cout << "--- Library Collection ---" << endl;
+    for (size_t i = 0; i < small.size(); i++) {
+        small[i].display();
+    }
+    cout << "Default constructors: " << Book::defaultBuilt << " | With data: " << Book::dataBuilt << endl;
+
+    // ---------------------------------------------------------
+    // BENCHMARK: 5M books by default, --large for 20M
+    // ---------------------------------------------------------
+    size_t total = argc > 1 && string(argv[1]) == "--large" ? 20000000 : 5000000;
+    const char* path = "books.csv";
+    {
+        const char* subjects[] = {"C++ Programming", "Database Systems", "Data Structures", "Operating Systems"};
+        FILE* out = fopen(path, "w");
+        for (size_t i = 0; i < total; i++) {
+            fprintf(out, "%zu,%s Volume %zu\n", 100 + i, subjects[i % 4], i);
+        }
+        fclose(out);
+    }
+
+    cout << "\n--- Loading " << total / 1000000 << "M books ---" << endl;
+    cout << "\t\t\tseconds\t\tpeak MB\t\tconstructors (default + data)" << endl;
+    measure("array + setData()\t", [path]() {
+        size_t n;
+        Book* library = loadArray(path, n);
+        delete[] library;
+        return n;
+    });
+    measure("BookCatalog (stream)\t", [path]() {
+        BookCatalog catalog;
+        loadCatalog(path, catalog);
+        return catalog.size();
+    });
+
+    remove(path);
+    return 0;
+}
+
+//-----------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+using namespace std;
+
+/*
+    PROBLEM:
+    The only way to look through the books is a loop over every object.
+    Finding every title that CONTAINS "Struct" means calling
+    title.find("Struct") on all of them: with tens of millions of books that
+    takes a long time for every single search.
+
+    SOLUTION: a TRIGRAM INDEX
+    - A trigram is 3 characters in a row. "Data" contains "Dat" and "ata".
+    - For every trigram, the index keeps a POSTING LIST: the numbers of all
+      books whose title contains it, in increasing order.
+    - A title can only contain "Struct" if it contains "Str", "tru", "ruc"
+      and "uct". So the answer is in the INTERSECTION of those 4 lists, and
+      only those few titles are checked with find().
+    - Lists are COMPRESSED: only the gap to the previous number is stored,
+      in as few bytes as it needs (1 byte for gaps below 128).
+    - Every 128 numbers start a new block whose first number is stored in
+      full, so the intersection can JUMP (gallop) over whole blocks.
+    - New books get higher numbers, so adding one only appends to lists.
+*/
+
+class Book {
+private:
+    int id;
+    string title;
+
+public:
+    Book(int i, string t) : id(i), title(move(t)) {}
+
+    int getId() const { return id; }
+    const string& getTitle() const { return title; }
+
+    void display() const {
+        cout << "Book ID: " << id << " | Title: " << title << endl;
+    }
+};
+
+// The numbers of all books containing one trigram, compressed
+class PostingList {
+private:
+    static const uint32_t BlockSize = 128;
+
+    vector<uint32_t> blockFirst;     // first number of each block, in full
+    vector<uint32_t> blockStart;     // where each block's gaps start in 'bytes'
+    vector<uint8_t> bytes;           // gaps, 7 bits per byte, high bit = "more bytes follow"
+    uint32_t last = 0;
+    uint32_t count = 0;
+
+public:
+    // A reading position in the list
+    struct Cursor {
+        uint32_t block;
+        uint32_t inBlock;            // numbers already read from this block
+        size_t at;                   // next byte to decode
+        uint32_t value;
+        bool done;
+    };
+
+    uint32_t size() const { return count; }
+
+    // Numbers must arrive in increasing order (a title adds itself only once)
+    void add(uint32_t book) {
+        if (count > 0 && book == last) {
+            return;
+        }
+        if (count % BlockSize == 0) {
+            blockFirst.push_back(book);
+            blockStart.push_back((uint32_t)bytes.size());
+        } else {
+            uint32_t gap = book - last;
+            while (gap >= 0x80) {
+                bytes.push_back((uint8_t)(gap | 0x80));
+                gap >>= 7;
+            }
+            bytes.push_back((uint8_t)gap);
+        }
+        last = book;
+        count++;
+    }
+
+    size_t bytesUsed() const {
+        return bytes.size() + (blockFirst.size() + blockStart.size()) * sizeof(uint32_t);
+    }
+
+    void openBlock(Cursor& c, uint32_t b) const {
+        c.block = b;
+        c.inBlock = 1;
+        c.at = blockStart[b];
+        c.value = blockFirst[b];
+        c.done = false;
+    }
+
+    Cursor begin() const {
+        Cursor c;
+        openBlock(c, 0);
+        return c;
+    }
+
+    void next(Cursor& c) const {
+        uint32_t blocks = (uint32_t)blockFirst.size();
+        uint32_t inThisBlock = c.block + 1 < blocks ? BlockSize : count - c.block * BlockSize;
+        if (c.inBlock < inThisBlock) {
+            uint32_t gap = 0;
+            int shift = 0;
+            uint8_t byte;
+            do {
+                byte = bytes[c.at++];
+                gap |= (uint32_t)(byte & 0x7F) << shift;
+                shift += 7;
+            } while (byte & 0x80);
+            c.value += gap;
+            c.inBlock++;
+        } else if (c.block + 1 < blocks) {
+            openBlock(c, c.block + 1);
+        } else {
+            c.done = true;
+        }
+    }
+
+    // Moves to the first number >= target
+    void seek(Cursor& c, uint32_t target) const {
+        if (c.done || c.value >= target) {
+            return;
+        }
+        uint32_t blocks = (uint32_t)blockFirst.size();
+        if (c.block + 1 < blocks && blockFirst[c.block + 1] <= target) {
+            // GALLOP: steps of 1, 2, 4, 8... blocks until we pass the target,
+            // then a binary search inside the last step.
+            uint32_t low = c.block + 1;
+            uint32_t step = 1;
+            while (low + step < blocks && blockFirst[low + step] <= target) {
+                low += step;
+                step *= 2;
+            }
+            uint32_t high = min(blocks, low + step);
+            uint32_t b = (uint32_t)(upper_bound(blockFirst.begin() + low, blockFirst.begin() + high, target)
+                                    - blockFirst.begin()) - 1;
+            openBlock(c, b);
+        }
+        while (!c.done && c.value < target) {
+            next(c);
+        }
+    }
+};
+
+class TitleIndex {
+private:
+    unordered_map<uint32_t, PostingList> lists;
+    uint32_t books = 0;
+
+    static uint32_t trigramAt(const string& s, size_t i) {
+        return (uint32_t)(unsigned char)s[i] << 16 | (uint32_t)(unsigned char)s[i + 1] << 8 | (unsigned char)s[i + 2];
+    }
+
+public:
+    // INCREMENTAL INSERT: the next book number is size()
+    void add(const string& title) {
+        for (size_t i = 0; i + 3 <= title.size(); i++) {
+            lists[trigramAt(title, i)].add(books);
+        }
+        books++;
+    }
+
+    uint32_t size() const { return books; }
+
+    size_t bytesUsed() const {
+        size_t total = lists.size() * (sizeof(uint32_t) + sizeof(PostingList));
+        for (const auto& entry : lists) total += entry.second.bytesUsed();
+        return total;
+    }
+
+    // Book numbers whose title contains 'text'. 'titleOf(n)' gives the title
+    // of book n, to confirm each candidate.
+    template <typename TitleOf>
+    vector<uint32_t> search(const string& text, TitleOf titleOf) const {
+        vector<uint32_t> found;
+        if (text.size() < 3) {
+            // Too short for a trigram: check every title
+            for (uint32_t n = 0; n < books; n++) {
+                if (titleOf(n).find(text) != string::npos) found.push_back(n);
+            }
+            return found;
+        }
+
+        vector<const PostingList*> needed;
+        for (size_t i = 0; i + 3 <= text.size(); i++) {
+            auto it = lists.find(trigramAt(text, i));
+            if (it == lists.end()) {
+                return found;                     // a trigram nobody has: no results
+            }
+            if (find(needed.begin(), needed.end(), &it->second) == needed.end()) {
+                needed.push_back(&it->second);
+            }
+        }
+        // Shortest list first: it decides how many candidates there are
+        sort(needed.begin(), needed.end(), [](const PostingList* a, const PostingList* b) {
+            return a->size() < b->size();
+        });
+
+        // INTERSECTION ("leapfrog"): every list jumps to the current candidate;
+        // a list that lands past it proposes a new, higher candidate.
+        vector<PostingList::Cursor> cursors;
+        for (const PostingList* list : needed) cursors.push_back(list->begin());
+        uint32_t candidate = cursors[0].value;
+        size_t agreeing = 1;
+        size_t k = 1 % cursors.size();
+        while (true) {
+            if (agreeing == cursors.size()) {
+                if (titleOf(candidate).find(text) != string::npos) {
+                    found.push_back(candidate);
+                }
+                needed[0]->next(cursors[0]);
+                if (cursors[0].done) break;
+                candidate = cursors[0].value;
+                agreeing = 1;
+                k = 1 % cursors.size();
+                continue;
+            }
+            needed[k]->seek(cursors[k], candidate);
+            if (cursors[k].done) break;
+            if (cursors[k].value == candidate) {
+                agreeing++;
+            } else {
+                candidate = cursors[k].value;
+                agreeing = 1;
+            }
+            k = (k + 1) % cursors.size();
+        }
+        return found;
+    }
+};
+
+unsigned long long nextRandom(unsigned long long& state) {
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    return state >> 33;
+}
+
+// Made-up titles: 2 to 5 words from a vocabulary of 50000 words, each
+// built from 2 to 4 syllables like "ka", "tre", "lom"
+vector<string> makeVocabulary(unsigned long long& seed) {
+    const char* consonants = "bcdfghklmnprstvz";
+    const char* vowels = "aeiou";
+    vector<string> words;
+    for (int w = 0; w < 50000; w++) {
+        string word;
+        int syllables = 2 + (int)(nextRandom(seed) % 3);
+        for (int s = 0; s < syllables; s++) {
+            word += consonants[nextRandom(seed) % 16];
+            word += vowels[nextRandom(seed) % 5];
+            if (nextRandom(seed) % 3 == 0) word += consonants[nextRandom(seed) % 16];
+        }
+        word[0] = (char)(word[0] - 'a' + 'A');
+        words.push_back(word);
+    }
+    return words;
+}
+
+int main(int argc, char* argv[]) {
+    vector<Book> library;
+    TitleIndex index;
+    for (const char* title : {"C++ Programming", "Database Systems", "Data Structures", "Structured Programming"}) {
+        library.emplace_back(101 + (int)library.size(), title);
+        index.add(title);                       // incremental: index stays up to date
+    }
+    auto titleOf = [&library](uint32_t n) -> const string& { return library[n].getTitle(); };
+    cout << "--- Titles containing \"Struct\" ---" << endl;
+    for (uint32_t n : index.search("Struct", titleOf)) {
+        library[n].display();
+    }
+
+    // ---------------------------------------------------------
+    // BENCHMARK: 5M titles by default, --large for 20M
+    // ---------------------------------------------------------
+    size_t total = argc > 1 && string(argv[1]) == "--large" ? 20000000 : 5000000;
+    unsigned long long seed = 23;
+    vector<string> words = makeVocabulary(seed);
+    library.clear();
+    library.reserve(total);
+    TitleIndex big;
+    size_t titleBytes = 0;
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < total; i++) {
+        string title = words[nextRandom(seed) % words.size()];
+        int more = 1 + (int)(nextRandom(seed) % 4);
+        for (int w = 0; w < more; w++) title += " " + words[nextRandom(seed) % words.size()];
+        titleBytes += title.size();
+        big.add(title);
+        library.emplace_back((int)i, move(title));
+    }
+    chrono::duration<double> buildTime = chrono::steady_clock::now() - start;
+
+    // Queries: a random piece (5 to 12 characters) of a random title
+    vector<string> queries;
+    for (int q = 0; q < 2000; q++) {
+        const string& title = library[nextRandom(seed) % total].getTitle();
+        size_t length = min(title.size(), (size_t)(5 + nextRandom(seed) % 8));
+        queries.push_back(title.substr(nextRandom(seed) % (title.size() - length + 1), length));
+    }
+
+    size_t indexMatches = 0;
+    start = chrono::steady_clock::now();
+    for (const string& q : queries) indexMatches += big.search(q, titleOf).size();
+    chrono::duration<double, micro> indexTime = chrono::steady_clock::now() - start;
+
+    // The linear scan is slow, so it only runs the first 20 queries
+    const int scanned = 20;
+    size_t scanMatches = 0;
+    bool same = true;
+    start = chrono::steady_clock::now();
+    for (int q = 0; q < scanned; q++) {
+        vector<uint32_t> found;
+        for (uint32_t n = 0; n < library.size(); n++) {
+            if (library[n].getTitle().find(queries[q]) != string::npos) found.push_back(n);
+        }
+        scanMatches += found.size();
+        same = same && found == big.search(queries[q], titleOf);
+    }
+    chrono::duration<double, micro> scanTime = chrono::steady_clock::now() - start;
+
+    cout << "\n--- " << total / 1000000 << "M titles (" << titleBytes / (1 << 20) << " MB of text) ---" << endl;
+    cout << "Index: built in " << buildTime.count() << " s, " << big.bytesUsed() / (1 << 20) << " MB" << endl;
+    cout << "Trigram index:     " << indexTime.count() / queries.size() << " us per query ("
+         << (double)indexMatches / queries.size() << " matches on average)" << endl;
+    cout << "Linear find() scan: " << scanTime.count() / scanned << " us per query" << endl;
+    cout << "Same results as the scan: " << (same ? "yes" : "NO") << " (" << scanMatches << " matches checked)" << endl;
+
+    return 0;
+}
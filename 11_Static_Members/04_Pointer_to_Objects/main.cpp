@@ -92,3 +92,756 @@ int main() {
 
     return 0;
 }
+
+//-----------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <functional>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+using namespace std;
+
+/*
+    PROBLEM:
+    The Student above keeps 'char* name', and usually each name is copied with
+    'new char[len + 1]'. Loading 5 million students then means 5 million tiny
+    heap allocations, and the same names ("Ali Khan") are stored thousands of times.
+
+    SOLUTION:
+    1. STRING ARENA: take memory from the heap in BIG blocks (1 MB) and place
+       many strings one after another inside each block.
+    2. INTERNING: store every DIFFERENT name only once. A Student keeps a
+       4-byte NameId (a handle) instead of a pointer to its own copy.
+*/
+
+class StringArena {
+private:
+    static const size_t BlockSize = 1 << 20;
+    vector<char*> blocks;
+    size_t used;                 // bytes used in the last block
+
+public:
+    StringArena() : used(BlockSize) {}
+
+    ~StringArena() {
+        for (char* block : blocks) {
+            delete[] block;      // ONE delete per block, not per string
+        }
+    }
+
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    // Copies 'text' into the arena and returns a view of the copy.
+    string_view store(string_view text) {
+        if (used + text.size() + 1 > BlockSize) {
+            blocks.push_back(new char[max(BlockSize, text.size() + 1)]);
+            used = 0;
+        }
+        char* place = blocks.back() + used;
+        memcpy(place, text.data(), text.size());
+        place[text.size()] = '\0';           // still usable as a C string
+        used += text.size() + 1;
+        return string_view(place, text.size());
+    }
+
+    size_t bytesReserved() const {
+        return blocks.size() * BlockSize;
+    }
+};
+
+typedef uint32_t NameId;
+
+class NamePool {
+private:
+    StringArena arena;
+    vector<string_view> names;           // NameId -> text
+
+    // text -> NameId, as a flat open-addressing table (one array, no nodes).
+    // slots[i] is 0 when empty, otherwise NameId + 1. 'tags' keeps part of
+    // each hash so most wrong slots are skipped without comparing text.
+    vector<uint32_t> slots;
+    vector<uint32_t> tags;
+
+    void grow() {
+        vector<uint32_t> oldSlots(slots.empty() ? 1024 : slots.size() * 2, 0);
+        oldSlots.swap(slots);
+        tags.assign(slots.size(), 0);
+        for (uint32_t slot : oldSlots) {
+            if (slot != 0) {
+                size_t h = hash<string_view>()(names[slot - 1]);
+                size_t i = h & (slots.size() - 1);
+                while (slots[i] != 0) {
+                    i = (i + 1) & (slots.size() - 1);
+                }
+                slots[i] = slot;
+                tags[i] = (uint32_t)(h >> (sizeof(size_t) * 4));
+            }
+        }
+    }
+
+public:
+    // Returns the existing id if this name was seen before.
+    NameId intern(string_view name) {
+        if ((names.size() + 1) * 2 > slots.size()) {
+            grow();                      // keep the table at most half full
+        }
+        size_t h = hash<string_view>()(name);
+        uint32_t tag = (uint32_t)(h >> (sizeof(size_t) * 4));
+        size_t i = h & (slots.size() - 1);
+        while (slots[i] != 0) {
+            if (tags[i] == tag && names[slots[i] - 1] == name) {
+                return slots[i] - 1;
+            }
+            i = (i + 1) & (slots.size() - 1);
+        }
+        NameId id = (NameId)names.size();
+        names.push_back(arena.store(name));
+        slots[i] = id + 1;
+        tags[i] = tag;
+        return id;
+    }
+
+    string_view lookup(NameId id) const {
+        return names[id];
+    }
+
+    size_t uniqueNames() const {
+        return names.size();
+    }
+
+    size_t approximateBytes() const {
+        return arena.bytesReserved() + names.capacity() * sizeof(string_view) +
+               slots.size() * 2 * sizeof(uint32_t);
+    }
+};
+
+class Student {
+private:
+    int rollNo;
+    NameId name;                 // 4 bytes instead of an 8-byte pointer + a heap copy
+
+public:
+    // --- STATIC DATA MEMBER ---
+    // ONE pool shared by all Student objects.
+    static NamePool names;
+
+    Student(int aNo, string_view aName) {
+        rollNo = aNo;
+        name = names.intern(aName);
+    }
+
+    string_view getName() const {
+        return names.lookup(name);
+    }
+
+    void show() const {
+        cout << "Roll No: " << rollNo << endl;
+        cout << "Name: " << getName() << endl;
+    }
+};
+
+NamePool Student::names;
+
+// BEFORE: every student owns a heap copy of its name (the usual char* pattern).
+class HeapNameStudent {
+private:
+    int rollNo;
+    char* name;
+
+public:
+    HeapNameStudent(int aNo, string_view aName) {
+        rollNo = aNo;
+        name = new char[aName.size() + 1];
+        memcpy(name, aName.data(), aName.size());
+        name[aName.size()] = '\0';
+    }
+
+    HeapNameStudent(HeapNameStudent&& other) noexcept : rollNo(other.rollNo), name(other.name) {
+        other.name = nullptr;
+    }
+
+    HeapNameStudent(const HeapNameStudent&) = delete;
+    HeapNameStudent& operator=(const HeapNameStudent&) = delete;
+
+    ~HeapNameStudent() {
+        delete[] name;
+    }
+
+    size_t nameLength() const {
+        return strlen(name);
+    }
+};
+
+// Builds the i-th name of the roster into 'buffer' (many students share names).
+string_view rosterName(size_t i, string& buffer) {
+    static const char* first[] = {"Muhammad", "Ali", "Ahmad", "Fatima", "Ayesha", "Hassan",
+                                  "Zainab", "Bilal", "Sara", "Usman", "Maryam", "Hamza"};
+    static const char* last[] = {"Khan", "Siddiqui", "Chaudhry", "Qureshi", "Malik",
+                                 "Butt", "Sheikh", "Hussain", "Raza", "Mirza"};
+    buffer = first[i % 12];
+    buffer += ' ';
+    buffer += last[(i / 12) % 10];
+    buffer += ' ';
+    buffer += to_string((i / 120) % 1000);        // 120,000 different names in total
+    return buffer;
+}
+
+int main() {
+    Student s1(101, "Ali Khan");
+    Student s2(102, "Ali Khan");                   // same text -> same NameId, no new copy
+    s1.show();
+    s2.show();
+    cout << "Unique names stored: " << Student::names.uniqueNames() << endl;
+
+    // ---------------------------------------------------------
+    // BENCHMARK: load a roster of 5 million students
+    // ---------------------------------------------------------
+    // Both timings cover the same work: building the roster. Freeing it is
+    // not timed on either side, because the shared pool is static and lives
+    // until the program ends.
+    const size_t roster = 5000000;
+    string buffer;
+    chrono::duration<double, milli> beforeTime, afterTime;
+
+    size_t heapBytes = 0;
+    {
+        auto start = chrono::steady_clock::now();
+        vector<HeapNameStudent> before;
+        before.reserve(roster);
+        for (size_t i = 0; i < roster; i++) {
+            string_view name = rosterName(i, buffer);
+            before.emplace_back((int)i, name);
+            heapBytes += name.size() + 1;
+        }
+        beforeTime = chrono::steady_clock::now() - start;
+        heapBytes += before.capacity() * sizeof(HeapNameStudent);
+    }
+
+    size_t arenaBytes = 0;
+    {
+        auto start = chrono::steady_clock::now();
+        vector<Student> after;
+        after.reserve(roster);
+        for (size_t i = 0; i < roster; i++) {
+            after.emplace_back((int)i, rosterName(i, buffer));
+        }
+        afterTime = chrono::steady_clock::now() - start;
+        arenaBytes = after.capacity() * sizeof(Student) + Student::names.approximateBytes();
+    }
+
+    cout << "\n--- Roster of " << roster << " students (time to build) ---" << endl;
+    cout << "char* per student: " << beforeTime.count() << " ms, "
+         << roster << " name allocations, ~" << heapBytes / (1 << 20) << " MB (+ malloc overhead)" << endl;
+    cout << "interned names:    " << afterTime.count() << " ms, "
+         << Student::names.uniqueNames() << " unique names, ~" << arenaBytes / (1 << 20) << " MB" << endl;
+    // The honest summary: interning always saves memory, but hashing and
+    // comparing every name can cost more time than malloc's small-size cache.
+    cout << "Interning is " << (afterTime < beforeTime ? "FASTER" : "SLOWER") << " here ("
+         << afterTime.count() / beforeTime.count() << "x the time) and uses "
+         << (double)heapBytes / arenaBytes << "x less memory" << endl;
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <new>
+using namespace std;
+
+/*
+    PROBLEM:
+    'new Car(...)' and 'delete' go to the general-purpose heap (malloc), which
+    must handle every size, keep bookkeeping for each block, and share its
+    data between threads. A simulation that creates and destroys millions of
+    short-lived Car objects per second spends most of its time in malloc.
+
+    SOLUTION: an OBJECT POOL that only hands out Car-sized slots
+    - Memory comes from the heap in big SLABS (4096 slots at a time).
+    - Free slots are linked into a list. Taking or returning one is a pointer
+      swap.
+    - Every thread keeps its OWN free list (thread_local), so threads do not
+      fight over a lock. Only every few hundred operations does a thread
+      swap a whole BATCH of slots with the shared pool.
+    - Car uses the pool through a class-level 'operator new' / 'operator
+      delete', so 'new Car(...)' and 'delete ptr' look exactly the same.
+*/
+
+template <typename T>
+class ObjectPool {
+private:
+    // A slot holds either a T (while in use) or the "next" pointer of the free list.
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static const size_t SlotsPerSlab = 4096;
+    static const size_t BatchSize = 256;         // slots moved between a thread and the pool at once
+
+    struct Chain {
+        Slot* head;
+        size_t length;
+    };
+
+    // The per-thread part. Its destructor gives the slots back when the thread ends.
+    struct ThreadCache {
+        ObjectPool* pool = nullptr;
+        Slot* head = nullptr;
+        size_t count = 0;
+        unsigned generation = 0;
+
+        ~ThreadCache() {
+            if (pool && count > 0 && generation == pool->generation.load()) {
+                pool->giveBack(Chain{head, count});
+            }
+        }
+    };
+
+    mutex lock;                                  // protects the two vectors below
+    vector<Slot*> slabs;
+    vector<Chain> chains;                        // free slots, in batches
+    atomic<unsigned> generation{0};              // changes on releaseAll()
+
+    ThreadCache& cache() {
+        // One cache per thread (and per T: there is one pool for each class)
+        thread_local ThreadCache c;
+        unsigned now = generation.load(memory_order_relaxed);
+        if (c.pool != this || c.generation != now) {
+            c.pool = this;
+            c.head = nullptr;                    // slots from before releaseAll() are gone
+            c.count = 0;
+            c.generation = now;
+        }
+        return c;
+    }
+
+    void giveBack(Chain chain) {
+        lock_guard<mutex> guard(lock);
+        chains.push_back(chain);
+    }
+
+    // Called when this thread's list is empty: take a batch from the pool,
+    // or cut a new slab into batches.
+    void refill(ThreadCache& c) {
+        lock_guard<mutex> guard(lock);
+        if (chains.empty()) {
+            Slot* slab = new Slot[SlotsPerSlab];
+            slabs.push_back(slab);
+            for (size_t start = 0; start < SlotsPerSlab; start += BatchSize) {
+                for (size_t i = start; i + 1 < start + BatchSize; i++) {
+                    slab[i].next = &slab[i + 1];
+                }
+                slab[start + BatchSize - 1].next = nullptr;
+                chains.push_back(Chain{&slab[start], BatchSize});
+            }
+        }
+        c.head = chains.back().head;
+        c.count = chains.back().length;
+        chains.pop_back();
+    }
+
+public:
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    ~ObjectPool() {
+        for (Slot* slab : slabs) {
+            delete[] slab;
+        }
+    }
+
+    void* allocate() {
+        ThreadCache& c = cache();
+        if (c.head == nullptr) {
+            refill(c);
+        }
+        Slot* slot = c.head;
+        c.head = slot->next;
+        c.count--;
+        return slot;
+    }
+
+    void deallocate(void* p) {
+        ThreadCache& c = cache();
+        Slot* slot = (Slot*)p;
+        slot->next = c.head;
+        c.head = slot;
+        c.count++;
+        if (c.count >= 2 * BatchSize) {
+            // Too many free slots in this thread: give one batch back, so a
+            // thread that only deletes does not collect all the memory.
+            Slot* first = c.head;
+            Slot* last = first;
+            for (size_t i = 1; i < BatchSize; i++) {
+                last = last->next;
+            }
+            c.head = last->next;
+            c.count -= BatchSize;
+            last->next = nullptr;
+            giveBack(Chain{first, BatchSize});
+        }
+    }
+
+    // BULK RELEASE: frees every slab at once, without visiting the objects.
+    // Only allowed when no object from this pool is alive and no other
+    // thread is using the pool right now.
+    void releaseAll() {
+        lock_guard<mutex> guard(lock);
+        for (Slot* slab : slabs) {
+            delete[] slab;
+        }
+        slabs.clear();
+        chains.clear();
+        generation.fetch_add(1);                 // every thread's list is now out of date
+    }
+
+    size_t bytesReserved() {
+        lock_guard<mutex> guard(lock);
+        return slabs.size() * SlotsPerSlab * sizeof(Slot);
+    }
+};
+
+class Car {
+private:
+    string model;
+    int speed;
+
+    // --- STATIC DATA MEMBER ---
+    // ONE pool shared by every Car object.
+    static ObjectPool<Car> pool;
+
+public:
+    Car(string m, int s) : model(move(m)), speed(s) {}
+
+    void display() {
+        cout << "Model: " << model << " | Speed: " << speed << " km/h" << endl;
+    }
+
+    // --- CLASS-LEVEL operator new / operator delete ---
+    // 'new Car(...)' calls this to get the memory, then runs the constructor.
+    // (They are static member functions, even without the word 'static'.)
+    void* operator new(size_t size) {
+        if (size != sizeof(Car)) {
+            return ::operator new(size);         // a derived class is bigger: use the normal heap
+        }
+        return pool.allocate();
+    }
+
+    void operator delete(void* p, size_t size) {
+        if (size != sizeof(Car)) {
+            ::operator delete(p);
+            return;
+        }
+        pool.deallocate(p);
+    }
+
+    static void releaseAll() {
+        pool.releaseAll();
+    }
+
+    static size_t poolBytes() {
+        return pool.bytesReserved();
+    }
+};
+
+ObjectPool<Car> Car::pool;
+
+// BEFORE: the same Car using the normal heap.
+class PlainCar {
+private:
+    string model;
+    int speed;
+
+public:
+    PlainCar(string m, int s) : model(move(m)), speed(s) {}
+};
+
+// Resident memory of this process in kB (Linux: /proc/self/status)
+long residentKB() {
+    ifstream status("/proc/self/status");
+    string key;
+    long value = 0;
+    while (status >> key) {
+        if (key == "VmRSS:") {
+            status >> value;
+            break;
+        }
+        status.ignore(1000, '\n');
+    }
+    return value;
+}
+
+// Every thread repeatedly creates 64 short-lived cars and deletes them.
+// Returns creates + deletes per second.
+template <typename T>
+double churnRate(int threads, int roundsPerThread) {
+    vector<thread> workers;
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([roundsPerThread]() {
+            T* cars[64];
+            for (int round = 0; round < roundsPerThread; round++) {
+                for (int i = 0; i < 64; i++) cars[i] = new T("Honda Civic", 100 + i);
+                for (int i = 0; i < 64; i++) delete cars[i];
+            }
+        });
+    }
+    for (thread& w : workers) {
+        w.join();
+    }
+    chrono::duration<double> seconds = chrono::steady_clock::now() - start;
+    return 2.0 * 64 * roundsPerThread * threads / seconds.count();
+}
+
+// Keeps 'count' cars alive at once and returns how much resident memory grew (kB).
+template <typename T>
+long residentGrowth(int count) {
+    vector<T*> cars(count);
+    long before = residentKB();
+    for (int i = 0; i < count; i++) cars[i] = new T("Honda Civic", i % 200);
+    long growth = residentKB() - before;
+    for (T* car : cars) delete car;
+    return growth;
+}
+
+int main() {
+    // Looks exactly like the first example, but the memory comes from the pool.
+    Car* heapPtr = new Car("Honda Civic", 180);
+    heapPtr->display();
+    delete heapPtr;
+
+    // ---------------------------------------------------------
+    // BENCHMARK 1: memory for 1M live cars
+    // (the pool runs first and keeps its slabs, so the plain version cannot
+    // simply reuse memory that was freed a moment ago)
+    // ---------------------------------------------------------
+    const int live = 1000000;
+    long poolKB = residentGrowth<Car>(live);
+    long plainKB = residentGrowth<PlainCar>(live);
+    cout << "\n--- " << live << " live cars (" << sizeof(Car) << " bytes each) ---" << endl;
+    cout << "new/delete: " << plainKB / 1024 << " MB resident" << endl;
+    cout << "pool:       " << poolKB / 1024 << " MB resident (" << Car::poolBytes() / (1 << 20) << " MB in slabs)" << endl;
+
+    // Bulk release: all slabs go back at once (no Car is alive here).
+    Car::releaseAll();
+    cout << "After releaseAll(): " << Car::poolBytes() << " bytes in slabs" << endl;
+
+    // ---------------------------------------------------------
+    // BENCHMARK 2: create/destroy rate, 1 to 8 threads
+    // ---------------------------------------------------------
+    cout << "\n--- Creates + deletes per second (millions) ---" << endl;
+    cout << "threads\tnew/delete\tpool" << endl;
+    for (int t = 1; t <= 8; t *= 2) {
+        int rounds = 100000 / t;
+        cout << t << "\t" << churnRate<PlainCar>(t, rounds) / 1e6
+             << "\t\t" << churnRate<Car>(t, rounds) / 1e6 << endl;
+    }
+
+    return 0;
+}
+
+//-----------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+using namespace std;
+
+/*
+    PROBLEM:
+    Raw pointers like 'Car* ptr = &myCar' or 'heapPtr' do not know when the
+    object they point to has been deleted. Using them afterwards is a
+    "dangling pointer" bug that may crash much later, or silently read
+    garbage. Also, cars created one by one with 'new' end up scattered all
+    over the heap, so a loop over all cars jumps around memory.
+
+    SOLUTION: a SLOT MAP
+    - All live cars are stored DENSELY in one vector (no gaps), so a loop
+      over every car reads memory in order.
+    - Instead of a pointer you get a HANDLE: {slot index, generation}.
+    - Every slot remembers its generation. Erasing a car increases it, so an
+      old handle no longer matches and is detected in O(1): get() returns
+      nullptr instead of a dangling pointer.
+*/
+
+class Car {
+private:
+    string model;
+    int speed;
+
+public:
+    Car(string m, int s) : model(move(m)), speed(s) {}
+
+    int getSpeed() const { return speed; }
+
+    void display() const {
+        cout << "Model: " << model << " | Speed: " << speed << " km/h" << endl;
+    }
+};
+
+struct CarHandle {
+    uint32_t slot;
+    uint32_t generation;
+};
+
+class CarSlotMap {
+private:
+    struct Slot {
+        uint32_t dense;          // position in 'cars' (or the next free slot, while free)
+        uint32_t generation;     // increases every time the car in this slot is erased
+    };
+
+    vector<Car> cars;            // live cars, no gaps
+    vector<uint32_t> slotOf;     // cars[i] belongs to slots[slotOf[i]]
+    vector<Slot> slots;
+    uint32_t freeSlot;           // first free slot (a linked list through Slot::dense)
+
+    static const uint32_t None = 0xFFFFFFFFu;
+
+public:
+    CarSlotMap() : freeSlot(None) {}
+
+    CarHandle insert(Car car) {
+        uint32_t s;
+        if (freeSlot != None) {
+            s = freeSlot;                        // reuse a slot; its generation is already new
+            freeSlot = slots[s].dense;
+        } else {
+            s = (uint32_t)slots.size();
+            slots.push_back(Slot{0, 0});
+        }
+        slots[s].dense = (uint32_t)cars.size();
+        cars.push_back(move(car));
+        slotOf.push_back(s);
+        return CarHandle{s, slots[s].generation};
+    }
+
+    // O(1): nullptr if the car was erased (the handle is "stale")
+    Car* get(CarHandle h) {
+        if (h.slot >= slots.size() || slots[h.slot].generation != h.generation) {
+            return nullptr;
+        }
+        return &cars[slots[h.slot].dense];
+    }
+
+    // Moves the LAST car into the hole, so the vector stays without gaps.
+    bool erase(CarHandle h) {
+        if (get(h) == nullptr) {
+            return false;
+        }
+        uint32_t hole = slots[h.slot].dense;
+        uint32_t last = (uint32_t)cars.size() - 1;
+        if (hole != last) {
+            cars[hole] = move(cars[last]);
+            slotOf[hole] = slotOf[last];
+            slots[slotOf[hole]].dense = hole;
+        }
+        cars.pop_back();
+        slotOf.pop_back();
+
+        slots[h.slot].generation++;              // every old handle is now stale
+        slots[h.slot].dense = freeSlot;
+        freeSlot = h.slot;
+        return true;
+    }
+
+    size_t size() const {
+        return cars.size();
+    }
+
+    // Iteration over the live cars, in contiguous memory
+    vector<Car>::iterator begin() { return cars.begin(); }
+    vector<Car>::iterator end() { return cars.end(); }
+};
+
+int main() {
+    CarSlotMap garage;
+    CarHandle corolla = garage.insert(Car("Toyota Corolla", 120));
+    CarHandle civic = garage.insert(Car("Honda Civic", 180));
+
+    garage.get(civic)->display();
+    garage.erase(civic);
+
+    // With a raw pointer this would be a dangling pointer. The handle knows.
+    if (garage.get(civic) == nullptr) {
+        cout << "Civic handle is stale: the car was erased" << endl;
+    }
+    CarHandle swift = garage.insert(Car("Suzuki Swift", 150));   // reuses the Civic's slot
+    cout << "Same slot, new generation: " << (swift.slot == civic.slot ? "yes" : "no")
+         << ", old handle still stale: " << (garage.get(civic) == nullptr ? "yes" : "no") << endl;
+    garage.get(corolla)->display();
+
+    // ---------------------------------------------------------
+    // BENCHMARK: 1M cars, then 1M erase + insert ("churn"), so the cars of the
+    // unique_ptr version were created at different times, like in a real program
+    // ---------------------------------------------------------
+    const int count = 1000000;
+    mt19937 rng(18);
+
+    CarSlotMap slotMap;
+    vector<CarHandle> handles;
+    vector<unique_ptr<Car>> pointers;
+    for (int i = 0; i < count; i++) {
+        handles.push_back(slotMap.insert(Car("Honda Civic", i % 200)));
+        pointers.push_back(make_unique<Car>("Honda Civic", i % 200));
+    }
+    for (int i = 0; i < count; i++) {
+        size_t victim = rng() % count;
+        slotMap.erase(handles[victim]);
+        handles[victim] = slotMap.insert(Car("Toyota Corolla", i % 200));
+        pointers[victim] = make_unique<Car>("Toyota Corolla", i % 200);
+    }
+
+    // Random lookups: one handle (or one pointer) at a time
+    vector<uint32_t> order(count);
+    for (int i = 0; i < count; i++) order[i] = (uint32_t)(rng() % count);
+
+    long long sum = 0;
+    const int passes = 20;
+    auto start = chrono::steady_clock::now();
+    for (int p = 0; p < passes; p++) {
+        for (Car& car : slotMap) sum += car.getSpeed();
+    }
+    chrono::duration<double, nano> slotIterate = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    for (int p = 0; p < passes; p++) {
+        for (const unique_ptr<Car>& car : pointers) sum -= car->getSpeed();
+    }
+    chrono::duration<double, nano> pointerIterate = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    for (uint32_t i : order) sum += slotMap.get(handles[i])->getSpeed();
+    chrono::duration<double, nano> slotLookup = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    for (uint32_t i : order) sum -= pointers[i]->getSpeed();
+    chrono::duration<double, nano> pointerLookup = chrono::steady_clock::now() - start;
+
+    cout << "\n--- " << count << " cars (ns per car) ---" << endl;
+    cout << "\t\t\titerate all\trandom lookup" << endl;
+    cout << "slot map + handles\t" << slotIterate.count() / passes / count << "\t\t" << slotLookup.count() / count << endl;
+    cout << "vector<unique_ptr>\t" << pointerIterate.count() / passes / count << "\t\t" << pointerLookup.count() / count << endl;
+    cout << "(checksum " << sum << ", 0 means both saw the same cars)" << endl;
+
+    return 0;
+}
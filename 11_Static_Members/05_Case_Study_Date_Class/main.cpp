@@ -167,3 +167,1003 @@ int main() {
 
     return 0;
 }
+
+//-----------------------------------------------------------------------------------------------
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <cassert>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+/*
+    PROBLEM:
+    The Date above stores day, month and year and 'addDay(40)' simply does
+    'day += 40', which leaves an impossible date like 50/12/2024. Doing it
+    properly with those three fields needs a loop over the months (and leap
+    years) for every addition or difference.
+
+    SOLUTION: store ONE number, the SERIAL DAY (days since 1 January 1970).
+    - addDay(x) is just 'days += x', always valid.
+    - difference between two dates is one subtraction.
+    - day of the week is one '%'.
+    - day/month/year are calculated from the serial day only when asked,
+      with a few multiplications and divisions (no loops, no month tables).
+
+    COMPILE-TIME DATES:
+    Everything in this Date is 'constexpr', so a date written in the code
+    (like the default date 7/3/2005) is calculated by the COMPILER and stored
+    in the program as a ready number; nothing runs at start-up. Month
+    lengths come from a table that is also built by the compiler.
+
+    BULK TEXT (parseBatch / formatBatch):
+    Printing with 'cout << d.getDay() << "/" << ...' and reading dates one by
+    one is far too slow for files with millions of lines. The static
+    functions parseBatch() and formatBatch() work on a whole buffer at once.
+
+    RANGE QUERIES (DateIndex):
+    "All records whose date is in [from, to]" over millions of records,
+    with a sorted index instead of a std::multimap<Date, ...>.
+*/
+
+// --- TOPIC: CALENDAR CONVERSIONS (constexpr, no loops) ---
+// The trick: count years from 1 MARCH, so February (with its leap day) is
+// the LAST month of the year. Then the month lengths 31,30,31,30,31,31,30,...
+// follow a fixed pattern that '(153 * m + 2) / 5' reproduces exactly.
+// A 400-year "era" always has 146097 days, which handles the leap-year rules.
+constexpr int daysFromCivil(int y, int m, int d) {
+    y -= m <= 2;
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const unsigned yearOfEra = (unsigned)(y - era * 400);                             // [0, 399]
+    const unsigned dayOfYear = (153 * (unsigned)(m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1; // [0, 365]
+    const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + (int)dayOfEra - 719468;                                  // 719468 = days from 1/3/0000 to 1/1/1970
+}
+
+// --- TOPIC: TEXT FORMATS FOR BULK PARSING / FORMATTING ---
+enum class DateFormat {
+    ISO,        // 2024-12-10
+    DMY         // 10/12/2024 (day and month may also have 1 digit: 7/3/2005)
+};
+
+struct CivilDate {
+    int year;
+    int month;
+    int day;
+};
+
+constexpr CivilDate civilFromDays(int z) {
+    z += 719468;
+    const int era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned dayOfEra = (unsigned)(z - era * 146097);                                      // [0, 146096]
+    const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365; // [0, 399]
+    const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const unsigned mp = (5 * dayOfYear + 2) / 153;                                               // March = 0
+    const unsigned d = dayOfYear - (153 * mp + 2) / 5 + 1;
+    const unsigned m = mp < 10 ? mp + 3 : mp - 9;
+    return CivilDate{(int)yearOfEra + era * 400 + (m <= 2), (int)m, (int)d};
+}
+
+// Divisible by 4, and not by 100 unless also by 400. For a multiple of 4,
+// "divisible by 100" is the same as "divisible by 25" and "divisible by 400"
+// the same as "divisible by 16", so only ONE real division is left.
+constexpr bool isLeapYear(int y) {
+    return (y & 3) == 0 && (y % 25 != 0 || (y & 15) == 0);
+}
+
+// --- TOPIC: TABLE GENERATED AT COMPILE TIME ---
+// A constexpr function fills the table; because 'monthLengths' is constexpr,
+// the loop runs inside the COMPILER and the program only contains the 26 bytes.
+struct MonthLengthTable {
+    uint8_t days[2][13];                 // [leap year?][month], month 0 unused
+};
+
+constexpr MonthLengthTable makeMonthLengthTable() {
+    MonthLengthTable table = {};
+    for (int leap = 0; leap < 2; leap++) {
+        for (int m = 1; m <= 12; m++) {
+            // 31 for Jan, Mar, May, Jul, Aug, Oct, Dec; 30 for the others
+            table.days[leap][m] = (uint8_t)(m == 2 ? 28 + leap : 30 + ((m + (m >> 3)) & 1));
+        }
+    }
+    return table;
+}
+
+constexpr MonthLengthTable monthLengths = makeMonthLengthTable();
+
+// 'm' must be 1..12: callers check it first (see isValidDate)
+constexpr int daysInMonth(int y, int m) {
+    assert(m >= 1 && m <= 12);
+    return monthLengths.days[isLeapYear(y)][m];
+}
+
+// Runtime validation is now one table lookup (after the range checks)
+constexpr bool isValidDate(int d, int m, int y) {
+    return m >= 1 && m <= 12 && d >= 1 && d <= daysInMonth(y, m);
+}
+
+// The compiler checks these while compiling; a wrong formula will not build.
+static_assert(daysFromCivil(1970, 1, 1) == 0, "serial day 0 is 1/1/1970");
+static_assert(daysFromCivil(2000, 3, 1) == 11017, "leap year 2000");
+static_assert(civilFromDays(11016).month == 2 && civilFromDays(11016).day == 29, "29/2/2000 exists");
+static_assert(civilFromDays(-1).year == 1969 && civilFromDays(-1).day == 31, "dates before 1970 work too");
+static_assert(daysInMonth(2024, 2) == 29 && daysInMonth(1900, 2) == 28 && daysInMonth(2023, 7) == 31 &&
+              daysInMonth(2023, 9) == 30 && daysInMonth(2023, 12) == 31, "month lengths");
+static_assert(isLeapYear(2000) && isLeapYear(2024) && !isLeapYear(1900) && !isLeapYear(2023), "leap years");
+static_assert(isValidDate(29, 2, 2000) && !isValidDate(29, 2, 1900) && !isValidDate(31, 4, 2024) &&
+              !isValidDate(0, 1, 2024) && !isValidDate(1, 13, 2024), "validation");
+
+class Date {
+private:
+    // --- TOPIC: DATA MEMBER ---
+    // The ONLY instance variable: days since 1 January 1970 (negative = earlier).
+    int days;
+
+    // --- TOPIC: STATIC DATA MEMBER ---
+    // Shared fallback date, exactly like before.
+    static Date defaultDate;
+
+    // Private constructor that takes the serial day as it is. It does not
+    // read defaultDate, so defaultDate itself can be built with it.
+    struct SerialDay { int value; };
+    constexpr explicit Date(SerialDay s) : days(s.value) {}
+
+    // Builds the serial day from fields, moving a too-large day back to the
+    // last day of the month (31/2 -> 28/2 or 29/2).
+    static constexpr int serialOf(int y, int m, int d) {
+        int last = daysInMonth(y, m);
+        return daysFromCivil(y, m, d > last ? last : d);
+    }
+
+    // Fills the missing fields from defaultDate (not constexpr: it reads a
+    // variable that can change while the program runs).
+    static int serialWithDefaults(int aDay, int aMonth, int aYear) {
+        CivilDate def = civilFromDays(defaultDate.days);
+        int y = aYear != 0 ? aYear : def.year;
+        int m = aMonth >= 1 && aMonth <= 12 ? aMonth : def.month;
+        int d = aDay >= 1 && aDay <= 31 ? aDay : def.day;
+        return serialOf(y, m, d);
+    }
+
+public:
+    // --- TOPIC: CONSTEXPR CONSTRUCTOR WITH DEFAULT ARGUMENTS ---
+    // A 0 (or out-of-range) field is taken from the static default date.
+    // defaultDate can change while the program runs, so it is read ONLY when
+    // a field is missing; 'constexpr Date d(14, 8, 1947);' never touches it
+    // and is calculated completely by the compiler.
+    constexpr Date(int aDay = 0, int aMonth = 0, int aYear = 0)
+        : days(aYear != 0 && aMonth >= 1 && aMonth <= 12 && aDay >= 1 && aDay <= 31
+                   ? serialOf(aYear, aMonth, aDay)
+                   : serialWithDefaults(aDay, aMonth, aYear)) {}
+
+    // Used to build the default date itself, and for serial numbers read from files.
+    static constexpr Date fromSerial(int serialDay) {
+        return Date(SerialDay{serialDay});
+    }
+
+    // --- TOPIC: GETTERS ---
+    // Calculated from the serial day (a few multiplications, no loops).
+    constexpr int getDay() const { return civilFromDays(days).day; }
+    constexpr int getMonth() const { return civilFromDays(days).month; }
+    constexpr int getYear() const { return civilFromDays(days).year; }
+    constexpr int getSerial() const { return days; }
+
+    // 0 = Sunday ... 6 = Saturday. 1/1/1970 was a Thursday (4).
+    constexpr int dayOfWeek() const {
+        return days >= -4 ? (days + 4) % 7 : (days + 5) % 7 + 6;
+    }
+
+    // --- TOPIC: SETTERS WITH REAL VALIDATION ---
+    // Invalid values are ignored, like in the original class, but now
+    // "valid" means valid for THIS month and year (no 30/2, no 29/2/2023).
+    constexpr void setDay(int aDay) {
+        CivilDate c = civilFromDays(days);
+        if (isValidDate(aDay, c.month, c.year))
+            days = daysFromCivil(c.year, c.month, aDay);
+    }
+    constexpr void setMonth(int aMonth) {
+        CivilDate c = civilFromDays(days);
+        if (aMonth >= 1 && aMonth <= 12)
+            days = serialOf(c.year, aMonth, c.day);
+    }
+    constexpr void setYear(int aYear) {
+        CivilDate c = civilFromDays(days);
+        days = serialOf(aYear, c.month, c.day);
+    }
+
+    // --- TOPIC: MEMBER FUNCTIONS (all O(1), result always a real date) ---
+    constexpr void addDay(int x) {
+        days += x;
+    }
+    // 31/1 + 1 month = last day of February
+    constexpr void addMonth(int x) {
+        CivilDate c = civilFromDays(days);
+        int total = c.year * 12 + (c.month - 1) + x;
+        int y = (total >= 0 ? total : total - 11) / 12;       // round towards -infinity
+        days = serialOf(y, total - y * 12 + 1, c.day);
+    }
+    constexpr void addYear(int x) {
+        addMonth(x * 12);
+    }
+
+    // Number of days from this date to 'other' (negative if 'other' is earlier)
+    constexpr int daysUntil(const Date& other) const {
+        return other.days - days;
+    }
+
+    // --- TOPIC: COMPARISON ---
+    // Earlier date = smaller serial day, so comparing dates is comparing ints.
+    constexpr bool operator<(const Date& other) const { return days < other.days; }
+    constexpr bool operator<=(const Date& other) const { return days <= other.days; }
+    constexpr bool operator==(const Date& other) const { return days == other.days; }
+    constexpr bool operator!=(const Date& other) const { return days != other.days; }
+
+    // --- TOPIC: STATIC MEMBER FUNCTION ---
+    // An invalid date is ignored, like in the setters above.
+    static void setDefaultDate(int aDay, int aMonth, int aYear) {
+        if (isValidDate(aDay, aMonth, aYear))
+            defaultDate.days = daysFromCivil(aYear, aMonth, aDay);
+    }
+
+    // --- TOPIC: STATIC MEMBER FUNCTIONS FOR WHOLE BUFFERS ---
+    // One date per line. EVERY line adds one Date to 'out' (a bad line adds
+    // the default date) and the numbers of the bad lines are returned, so a
+    // broken row never stops the batch and no exception is thrown.
+    static vector<size_t> parseBatch(const char* text, size_t length, DateFormat format, vector<Date>& out);
+
+    // Appends one line per date to 'out'. Years 0 to 9999 take the fast path;
+    // any other year (reachable with addDay, setYear or fromSerial) is still
+    // written correctly, just more slowly.
+    static void formatBatch(const Date* dates, size_t count, DateFormat format, string& out);
+};
+
+// --- TOPIC: STATIC VARIABLE INITIALIZATION ---
+// 7/3/2005 as a serial day. fromSerial() is used because the normal
+// constructor reads defaultDate, which does not exist yet at this point.
+// The initializer is a constant expression, so the value is stored in the
+// program file itself (no code runs before main). In C++20, 'constinit'
+// makes the compiler PROVE this, and refuse to build otherwise.
+#if defined(__cpp_constinit)
+constinit
+#endif
+Date Date::defaultDate = Date::fromSerial(daysFromCivil(2005, 3, 7));
+
+// --- TOPIC: static_assert TESTS ---
+// These run inside the compiler: if the Date class had a bug here, the
+// program would not compile at all.
+constexpr Date independenceDay(14, 8, 1947);
+static_assert(independenceDay.getDay() == 14 && independenceDay.getMonth() == 8 &&
+              independenceDay.getYear() == 1947, "fields survive the round trip");
+static_assert(independenceDay.dayOfWeek() == 4, "14/8/1947 was a Thursday");
+static_assert(Date(29, 2, 2024).getDay() == 29, "29/2 exists in a leap year");
+static_assert(Date(29, 2, 2023).getDay() == 28, "29/2/2023 becomes the last day of February");
+static_assert(Date(1, 1, 2024).daysUntil(Date(1, 1, 2025)) == 366, "2024 has 366 days");
+static_assert([] {
+    Date d(31, 12, 2024);
+    d.addDay(1);
+    return d.getDay() == 1 && d.getMonth() == 1 && d.getYear() == 2025;
+}(), "adding a day crosses the year");
+static_assert([] {
+    Date d(31, 1, 2023);
+    d.addMonth(1);
+    d.setDay(30);                    // ignored: February 2023 has no 30th
+    return d.getDay() == 28 && d.getMonth() == 2;
+}(), "addMonth clamps, setDay validates");
+
+// --- TOPIC: BULK PARSING ---
+// Each line is at most 16 bytes, so ONE 16-byte SSE2 load sees the whole line.
+// Three compares tell us, for every byte at once, whether it is a digit,
+// a separator ('-' or '/') or the end of the line.
+struct LineMasks {
+    uint32_t digits;
+    uint32_t separators;
+    uint32_t newlines;
+};
+
+static LineMasks scanLine(const char* p, char separator) {
+    LineMasks m;
+#if defined(__SSE2__)
+    __m128i bytes = _mm_loadu_si128((const __m128i*)p);
+    // A byte is a digit if (byte - '0'), seen as unsigned, is at most 9.
+    __m128i offset = _mm_sub_epi8(bytes, _mm_set1_epi8('0'));
+    __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(9)), offset);
+    m.digits = (uint32_t)_mm_movemask_epi8(isDigit);
+    m.separators = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(separator)));
+    m.newlines = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')));
+#else
+    m.digits = m.separators = m.newlines = 0;
+    for (int k = 0; k < 16; k++) {
+        m.digits |= (uint32_t)(p[k] >= '0' && p[k] <= '9') << k;
+        m.separators |= (uint32_t)(p[k] == separator) << k;
+        m.newlines |= (uint32_t)(p[k] == '\n') << k;
+    }
+#endif
+    return m;
+}
+
+// Allowed widths of the three fields: ISO is yyyy-mm-dd, DMY is d/m/yyyy.
+struct FieldRule {
+    int minWidth[3];
+    int maxWidth[3];
+    char separator;
+};
+
+static const FieldRule isoRule = {{4, 2, 2}, {4, 2, 2}, '-'};
+static const FieldRule dmyRule = {{1, 1, 4}, {2, 2, 4}, '/'};
+
+// Converts a field of 1 to 4 digits without a loop ("SIMD within a register"):
+// the 4 bytes are loaded into one integer (first digit in the lowest byte on
+// little-endian CPUs such as x86 and ARM), shifted so the missing digits
+// become leading zeros, and combined in two steps: pairs of digits first,
+// then the two pairs. Big-endian CPUs use a plain loop instead.
+static int readNumber(const char* p, int width) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    uint32_t x;
+    memcpy(&x, p, 4);
+    x = (x - 0x30303030u) << (8 * (4 - width));
+    x = x * 10 + (x >> 8);                              // bytes 0 and 2 now hold 2-digit numbers
+    return (int)((x & 0xFF) * 100 + ((x >> 16) & 0xFF));
+#else
+    int value = 0;
+    for (int k = 0; k < width; k++) {
+        value = value * 10 + (p[k] - '0');
+    }
+    return value;
+#endif
+}
+
+// Checks the line [p, p + end) using the masks; fills the three numbers.
+static bool splitFields(const char* p, int end, const LineMasks& m, const FieldRule& rule, int value[3]) {
+    uint32_t inLine = (1u << end) - 1;
+    uint32_t separators = m.separators & inLine;
+    uint32_t afterFirst = separators & (separators - 1);          // clears the lowest bit
+    if (afterFirst == 0 || (afterFirst & (afterFirst - 1)) != 0 || ((m.digits | separators) & inLine) != inLine) {
+        return false;                                   // not exactly 2 separators, or a non-digit
+    }
+    int first = __builtin_ctz(separators);
+    int second = __builtin_ctz(afterFirst);
+    int width0 = first, width1 = second - first - 1, width2 = end - second - 1;
+    if (width0 < rule.minWidth[0] || width0 > rule.maxWidth[0] ||
+        width1 < rule.minWidth[1] || width1 > rule.maxWidth[1] ||
+        width2 < rule.minWidth[2] || width2 > rule.maxWidth[2]) {
+        return false;
+    }
+    value[0] = readNumber(p, width0);
+    value[1] = readNumber(p + first + 1, width1);
+    value[2] = readNumber(p + second + 1, width2);
+    return true;
+}
+
+vector<size_t> Date::parseBatch(const char* text, size_t length, DateFormat format, vector<Date>& out) {
+    const FieldRule& rule = format == DateFormat::ISO ? isoRule : dmyRule;
+    vector<size_t> badRows;
+    char tail[16];
+    size_t pos = 0;
+    for (size_t row = 0; pos < length; row++) {
+        const char* p = text + pos;
+        size_t available = length - pos;
+        uint32_t endMask = 0;
+        if (available < 16) {
+            // Near the end of the buffer: copy the rest, so the 16-byte load
+            // never reads past the caller's memory.
+            memset(tail, 0, sizeof(tail));
+            memcpy(tail, p, available);
+            p = tail;
+            endMask = ~0u << available;                 // the buffer end also ends the line
+        }
+        LineMasks m = scanLine(p, rule.separator);
+        endMask = (endMask | m.newlines) & 0xFFFF;
+
+        bool ok = false;
+        size_t lineLength;
+        if (endMask != 0) {
+            lineLength = (size_t)__builtin_ctz(endMask);
+            int end = (int)lineLength;
+            if (end > 0 && p[end - 1] == '\r') {
+                end--;                                  // Windows line ending
+            }
+            int value[3];
+            if (splitFields(p, end, m, rule, value)) {
+                int y = format == DateFormat::ISO ? value[0] : value[2];
+                int mo = value[1];
+                int d = format == DateFormat::ISO ? value[2] : value[0];
+                if (mo >= 1 && mo <= 12 && d >= 1 && d <= daysInMonth(y, mo)) {
+                    out.push_back(fromSerial(daysFromCivil(y, mo, d)));
+                    ok = true;
+                }
+            }
+        } else {
+            // No line end in 16 bytes: too long to be a date. Skip the line.
+            const char* newline = (const char*)memchr(text + pos, '\n', available);
+            lineLength = newline ? (size_t)(newline - (text + pos)) : available;
+        }
+        if (!ok) {
+            out.push_back(defaultDate);
+            badRows.push_back(row);
+        }
+        pos += lineLength + 1;
+    }
+    return badRows;
+}
+
+// --- TOPIC: BULK FORMATTING ---
+// "00", "01", ... "99": two digits are written with one 2-byte copy
+// instead of a division per digit.
+struct DigitPairs {
+    char text[200];
+
+    constexpr DigitPairs() : text() {
+        for (int i = 0; i < 100; i++) {
+            text[2 * i] = (char)('0' + i / 10);
+            text[2 * i + 1] = (char)('0' + i % 10);
+        }
+    }
+
+    constexpr const char* operator[](int i) const {
+        return text + 2 * i;
+    }
+};
+
+static constexpr DigitPairs digitPairs;            // also filled by the compiler
+
+void Date::formatBatch(const Date* dates, size_t count, DateFormat format, string& out) {
+    size_t start = out.size();
+    out.resize(start + count * 11);                     // longest line: "yyyy-mm-dd\n"
+    char* p = &out[start];
+    for (size_t i = 0; i < count; i++) {
+        CivilDate c = civilFromDays(dates[i].days);
+        if (c.year < 0 || c.year > 9999) {
+            // digitPairs only covers 4-digit years: write this line with
+            // snprintf ("-0044-03-15", "15/3/12345"). It needs more than the
+            // 11 bytes planned, so the string grows first.
+            size_t done = (size_t)(p - out.data());
+            out.resize(out.size() + 16);
+            p = &out[done];
+            int n = format == DateFormat::ISO
+                        ? snprintf(p, out.size() - done, "%05d-%02d-%02d\n", c.year, c.month, c.day)
+                        : snprintf(p, out.size() - done, "%d/%d/%d\n", c.day, c.month, c.year);
+            p += n;
+        } else if (format == DateFormat::ISO) {
+            memcpy(p, digitPairs[c.year / 100], 2);
+            memcpy(p + 2, digitPairs[c.year % 100], 2);
+            p[4] = '-';
+            memcpy(p + 5, digitPairs[c.month], 2);
+            p[7] = '-';
+            memcpy(p + 8, digitPairs[c.day], 2);
+            p[10] = '\n';
+            p += 11;
+        } else {
+            int dayWidth = c.day < 10 ? 1 : 2;          // no leading zero: 7/3/2005
+            memcpy(p, digitPairs[c.day] + 2 - dayWidth, dayWidth);
+            p += dayWidth;
+            *p++ = '/';
+            int monthWidth = c.month < 10 ? 1 : 2;
+            memcpy(p, digitPairs[c.month] + 2 - monthWidth, monthWidth);
+            p += monthWidth;
+            *p++ = '/';
+            memcpy(p, digitPairs[c.year / 100], 2);
+            memcpy(p + 2, digitPairs[c.year % 100], 2);
+            p[4] = '\n';
+            p += 5;
+        }
+    }
+    out.resize((size_t)(p - out.data()));
+}
+
+// --- TOPIC: SORTED INDEX FOR RANGE QUERIES ---
+// Answers "which records have a date in [from, to]?" for millions of records.
+//
+// - All dates are kept SORTED in one flat array, with the record numbers in
+//   a second array in the same order. A range query finds where 'from'
+//   starts and where 'to' ends; every record in between is an answer.
+// - Finding the start is the slow part (a plain binary search jumps all over
+//   a huge array). So the keys are cut into blocks of 16, and the LAST key of
+//   each block goes into a small search tree stored in "Eytzinger" order:
+//   the root at [1], its children at [2] and [3], the children of k at 2k and
+//   2k+1. The first levels of the tree share a few cache lines, and the
+//   next nodes can be fetched (prefetched) before they are needed.
+// - Inside the block, SSE2 compares 4 keys at a time to count how many are
+//   smaller than the key we look for.
+class DateIndex {
+private:
+    static const int BlockSize = 16;
+
+    vector<int> keys;              // serial days, sorted; padded with INT32_MAX to whole blocks
+    vector<uint32_t> records;      // record number for each key (same order)
+
+    struct Node {
+        int lastKey;               // last key of the block
+        uint32_t block;            // which block (kept next to the key: no extra cache miss)
+    };
+    vector<Node> tree;             // [1..blocks], in Eytzinger order
+    size_t count;
+
+    // Fills the tree by an in-order walk: visiting the nodes "left, self,
+    // right" hands out the blocks in sorted order.
+    size_t build(size_t k, size_t nextBlock) {
+        if (k < tree.size()) {
+            nextBlock = build(2 * k, nextBlock);
+            tree[k] = Node{keys[nextBlock * BlockSize + BlockSize - 1], (uint32_t)nextBlock};
+            nextBlock = build(2 * k + 1, nextBlock + 1);
+        }
+        return nextBlock;
+    }
+
+    // Number of keys in block 'b' that are smaller than 'key'
+    int countSmaller(size_t b, int key) const {
+        const int* block = &keys[b * BlockSize];
+#if defined(__SSE2__)
+        __m128i target = _mm_set1_epi32(key);
+        __m128i smaller = _mm_setzero_si128();
+        for (int i = 0; i < BlockSize; i += 4) {
+            // each lane is -1 where block[i] < key; subtracting adds 1
+            __m128i lanes = _mm_loadu_si128((const __m128i*)(block + i));
+            smaller = _mm_sub_epi32(smaller, _mm_cmplt_epi32(lanes, target));
+        }
+        smaller = _mm_add_epi32(smaller, _mm_shuffle_epi32(smaller, _MM_SHUFFLE(1, 0, 3, 2)));
+        smaller = _mm_add_epi32(smaller, _mm_shuffle_epi32(smaller, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(smaller);
+#else
+        int smaller = 0;
+        for (int i = 0; i < BlockSize; i++) {
+            smaller += block[i] < key;
+        }
+        return smaller;
+#endif
+    }
+
+    // Position of the first key >= 'key' (or size() if there is none)
+    size_t firstNotBefore(int key) const {
+        size_t k = 1;
+        size_t blocks = tree.size() - 1;
+        while (k <= blocks) {
+            // 3 levels ahead (8 nodes = 64 bytes); near the leaves that is past
+            // the end, so the last node is fetched instead (no branch needed)
+            __builtin_prefetch(tree.data() + min(8 * k, blocks));
+            k = 2 * k + (tree[k].lastKey < key);          // no if: no wrong guesses
+        }
+        // Undo the last "go right" steps: k becomes the last node where we went left.
+        k >>= __builtin_ctzll(~(unsigned long long)k) + 1;
+        if (k == 0) {
+            return count;                                 // every key is smaller
+        }
+        size_t b = tree[k].block;
+        return b * BlockSize + (size_t)countSmaller(b, key);
+    }
+
+public:
+    DateIndex() : tree(1, Node{0, 0}), count(0) {}
+
+    // BULK LOAD: date i belongs to record i. Sorting everything once is
+    // much cheaper than inserting records one by one.
+    void bulkLoad(const Date* dates, size_t n) {
+        // Key and record number packed into one 64-bit number, so one sort
+        // orders by date (and by record number for equal dates).
+        vector<uint64_t> packed(n);
+        for (size_t i = 0; i < n; i++) {
+            uint32_t biased = (uint32_t)dates[i].getSerial() ^ 0x80000000u;   // negative days sort first
+            packed[i] = (uint64_t)biased << 32 | (uint32_t)i;
+        }
+        sort(packed.begin(), packed.end());
+
+        count = n;
+        size_t blocks = (n + BlockSize - 1) / BlockSize;
+        keys.assign(blocks * BlockSize, INT32_MAX);
+        records.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            keys[i] = (int)((uint32_t)(packed[i] >> 32) ^ 0x80000000u);
+            records[i] = (uint32_t)packed[i];
+        }
+        tree.assign(blocks + 1, Node{0, 0});
+        build(1, 0);
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    // Same meaning as std::lower_bound / std::upper_bound on the sorted dates
+    size_t lowerBound(const Date& d) const {
+        return firstNotBefore(d.getSerial());
+    }
+
+    size_t upperBound(const Date& d) const {
+        return firstNotBefore(d.getSerial() + 1);      // dates are whole days
+    }
+
+    Date dateAt(size_t position) const {
+        return Date::fromSerial(keys[position]);
+    }
+
+    // RANGE SCAN: the record numbers of every date in [from, to],
+    // as one contiguous piece of the 'records' array.
+    struct Range {
+        const uint32_t* first;
+        const uint32_t* last;
+
+        const uint32_t* begin() const { return first; }
+        const uint32_t* end() const { return last; }
+        size_t size() const { return (size_t)(last - first); }
+    };
+
+    Range between(const Date& from, const Date& to) const {
+        size_t lo = lowerBound(from);
+        size_t hi = upperBound(to);
+        if (hi < lo) {
+            hi = lo;                                    // 'to' before 'from': empty range
+        }
+        return Range{records.data() + lo, records.data() + hi};
+    }
+};
+
+// BEFORE: the "obvious" way with three fields. Every addition or
+// difference walks month by month (or year by year).
+class NaiveDate {
+private:
+    int day, month, year;
+
+public:
+    NaiveDate(int d = 1, int m = 1, int y = 1970) : day(d), month(m), year(y) {}
+
+    void addDay(int x) {
+        day += x;
+        while (day > daysInMonth(year, month)) {
+            day -= daysInMonth(year, month);
+            if (++month > 12) { month = 1; year++; }
+        }
+        while (day < 1) {
+            if (--month < 1) { month = 12; year--; }
+            day += daysInMonth(year, month);
+        }
+    }
+
+    // Days from 1/1/1970, counted year by year and month by month
+    int daysSinceEpoch() const {
+        int total = 0;
+        for (int y = 1970; y < year; y++) total += isLeapYear(y) ? 366 : 365;
+        for (int y = year; y < 1970; y++) total -= isLeapYear(y) ? 366 : 365;
+        for (int m = 1; m < month; m++) total += daysInMonth(year, m);
+        return total + day - 1;
+    }
+
+    int daysUntil(const NaiveDate& other) const {
+        return other.daysSinceEpoch() - daysSinceEpoch();
+    }
+
+    // Validation the usual way: a switch and the full leap-year rule
+    static bool isValid(int d, int m, int y) {
+        int last;
+        switch (m) {
+            case 1: case 3: case 5: case 7: case 8: case 10: case 12: last = 31; break;
+            case 4: case 6: case 9: case 11: last = 30; break;
+            case 2: last = (y % 4 == 0 && (y % 100 != 0 || y % 400 == 0)) ? 29 : 28; break;
+            default: return false;
+        }
+        return d >= 1 && d <= last;
+    }
+
+    int getDay() const { return day; }
+    int getMonth() const { return month; }
+    int getYear() const { return year; }
+};
+
+// Tiny random number generator, identical for both versions
+static inline uint32_t nextRandom(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+const int TableSize = 4096;
+
+int main(int argc, char* argv[]) {
+    const char* dayNames[] = {"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"};
+
+    Date d1;                                   // 7/3/2005 (default)
+    Date d2(10, 12, 2024);
+    cout << "d1: " << d1.getDay() << "/" << d1.getMonth() << "/" << d1.getYear() << endl;
+    cout << "d2: " << d2.getDay() << "/" << d2.getMonth() << "/" << d2.getYear()
+         << " (" << dayNames[d2.dayOfWeek()] << ")" << endl;
+
+    d2.addDay(40);                             // the old class would print 50/12/2024
+    cout << "d2 after addDay(40): " << d2.getDay() << "/" << d2.getMonth() << "/" << d2.getYear() << endl;
+
+    Date d3(31, 1, 2024);
+    d3.addMonth(1);                            // no 31/2: moved to the last day of February
+    cout << "31/1/2024 + 1 month: " << d3.getDay() << "/" << d3.getMonth() << "/" << d3.getYear() << endl;
+    cout << "Days from d1 to d2: " << d1.daysUntil(d2) << endl;
+
+    Date::setDefaultDate(1, 13, 2030);         // no month 13: the default stays 7/3/2005
+    Date d4;
+    cout << "Default after setDefaultDate(1, 13, 2030): "
+         << d4.getDay() << "/" << d4.getMonth() << "/" << d4.getYear() << endl;
+
+    // ---------------------------------------------------------
+    // Random start dates between 1900 and 2100, same for both versions
+    // ---------------------------------------------------------
+    static Date serialTable[TableSize];
+    static NaiveDate naiveTable[TableSize];
+    uint32_t seed = 2024;
+    for (int i = 0; i < TableSize; i++) {
+        int serial = daysFromCivil(1900, 1, 1) + (int)(nextRandom(seed) % 73048);
+        CivilDate c = civilFromDays(serial);
+        serialTable[i] = Date::fromSerial(serial);
+        naiveTable[i] = NaiveDate(c.day, c.month, c.year);
+    }
+
+    // Check: both versions must agree on 1M random operations
+    bool same = true;
+    seed = 7;
+    for (int i = 0; i < 1000000 && same; i++) {
+        int offset = (int)(nextRandom(seed) % 2001) - 1000;
+        int a = i & (TableSize - 1), b = (i * 7 + 3) & (TableSize - 1);
+        Date s = serialTable[a];
+        NaiveDate n = naiveTable[a];
+        s.addDay(offset);
+        n.addDay(offset);
+        same = s.getDay() == n.getDay() && s.getMonth() == n.getMonth() && s.getYear() == n.getYear() &&
+               serialTable[a].daysUntil(serialTable[b]) == naiveTable[a].daysUntil(naiveTable[b]);
+    }
+    cout << "\nSerial and naive results match: " << (same ? "yes" : "NO") << endl;
+
+    // ---------------------------------------------------------
+    // BENCHMARK: 100M additions (+ reading the day back) and 100M differences
+    // ---------------------------------------------------------
+    const long long operations = 100000000;
+    long long checksum = 0;
+
+    auto start = chrono::steady_clock::now();
+    seed = 1;
+    for (long long i = 0; i < operations; i++) {
+        Date d = serialTable[i & (TableSize - 1)];
+        d.addDay((int)(nextRandom(seed) % 2001) - 1000);
+        checksum += d.getDay();
+    }
+    for (long long i = 0; i < operations; i++) {
+        checksum += serialTable[i & (TableSize - 1)].daysUntil(serialTable[(i * 7 + 3) & (TableSize - 1)]);
+    }
+    chrono::duration<double> serialTime = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    seed = 1;
+    for (long long i = 0; i < operations; i++) {
+        NaiveDate d = naiveTable[i & (TableSize - 1)];
+        d.addDay((int)(nextRandom(seed) % 2001) - 1000);
+        checksum -= d.getDay();
+    }
+    for (long long i = 0; i < operations; i++) {
+        checksum -= naiveTable[i & (TableSize - 1)].daysUntil(naiveTable[(i * 7 + 3) & (TableSize - 1)]);
+    }
+    chrono::duration<double> naiveTime = chrono::steady_clock::now() - start;
+
+    cout << "\n--- " << operations / 1000000 << "M additions + " << operations / 1000000 << "M differences ---" << endl;
+    cout << "serial day:     " << serialTime.count() << " s" << endl;
+    cout << "month stepping: " << naiveTime.count() << " s" << endl;
+    cout << "(checksum " << checksum << ", 0 means both gave the same answers)" << endl;
+
+    // ---------------------------------------------------------
+    // BENCHMARK: validated construction from (day, month, year)
+    // About 1 in 9 of the random triples is not a real date.
+    // ---------------------------------------------------------
+    static int triples[TableSize][3];
+    seed = 15;
+    for (int i = 0; i < TableSize; i++) {
+        triples[i][0] = 1 + (int)(nextRandom(seed) % 32);
+        triples[i][1] = 1 + (int)(nextRandom(seed) % 13);
+        triples[i][2] = 1900 + (int)(nextRandom(seed) % 201);
+    }
+
+    long long tableValid = 0, switchValid = 0;
+    start = chrono::steady_clock::now();
+    for (long long i = 0; i < operations; i++) {
+        const int* t = triples[i & (TableSize - 1)];
+        tableValid += isValidDate(t[0], t[1], t[2]);
+    }
+    chrono::duration<double> tableTime = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    for (long long i = 0; i < operations; i++) {
+        const int* t = triples[i & (TableSize - 1)];
+        switchValid += NaiveDate::isValid(t[0], t[1], t[2]);
+    }
+    chrono::duration<double> switchTime = chrono::steady_clock::now() - start;
+
+    long long serialSum = 0;
+    start = chrono::steady_clock::now();
+    for (long long i = 0; i < operations; i++) {
+        const int* t = triples[i & (TableSize - 1)];
+        Date d(t[0], t[1], t[2]);             // day 0 or month 13 comes from the default date; 31/4 becomes 30/4
+        serialSum += d.getSerial();
+    }
+    chrono::duration<double> constructTime = chrono::steady_clock::now() - start;
+
+    cout << "\n--- " << operations / 1000000 << "M validations (million per second) ---" << endl;
+    cout << "table lookup:     " << operations / tableTime.count() / 1e6 << " (" << tableValid << " valid)" << endl;
+    cout << "switch + % rules: " << operations / switchTime.count() / 1e6 << " (" << switchValid << " valid)" << endl;
+    cout << "Date(d, m, y):    " << operations / constructTime.count() / 1e6 << " (checksum " << serialSum << ")" << endl;
+
+    // ---------------------------------------------------------
+    // BULK TEXT: parse a buffer with some broken lines
+    // ---------------------------------------------------------
+    const char sample[] = "10/12/2024\n7/3/2005\n31/2/2024\n10-12-2024\n29/2/2024\nhello\n1/1/2030";
+    vector<Date> parsed;
+    vector<size_t> badRows = Date::parseBatch(sample, sizeof(sample) - 1, DateFormat::DMY, parsed);
+    string text;
+    Date::formatBatch(parsed.data(), parsed.size(), DateFormat::ISO, text);
+    cout << "\nParsed " << parsed.size() << " lines as ISO:\n" << text;
+    cout << "Bad lines (counting from 0):";
+    for (size_t row : badRows) cout << " " << row;
+    cout << endl;
+
+    Date farAway[] = {Date(1, 6, 12345), Date(15, 3, -44)};   // years outside 0-9999
+    string farText;
+    Date::formatBatch(farAway, 2, DateFormat::DMY, farText);
+    Date::formatBatch(farAway, 2, DateFormat::ISO, farText);
+    cout << "Years outside 0-9999:\n" << farText;
+
+    // ---------------------------------------------------------
+    // BENCHMARK: 10M dates as text, in GB/s of text
+    // ---------------------------------------------------------
+    const size_t lines = 10000000;
+    vector<Date> dates;
+    dates.reserve(lines);
+    seed = 99;
+    for (size_t i = 0; i < lines; i++) {
+        dates.push_back(Date::fromSerial(daysFromCivil(1900, 1, 1) + (int)(nextRandom(seed) % 73048)));
+    }
+
+    cout << "\n--- " << lines / 1000000 << "M dates (GB/s of text) ---" << endl;
+    cout << "format\tformatBatch\tstrftime\tparseBatch\tget_time" << endl;
+    DateFormat formats[2] = {DateFormat::ISO, DateFormat::DMY};
+    const char* patterns[2] = {"%Y-%m-%d", "%d/%m/%Y"};
+    for (int f = 0; f < 2; f++) {
+        string fast;
+        fast.reserve(lines * 11);
+        auto t0 = chrono::steady_clock::now();
+        Date::formatBatch(dates.data(), lines, formats[f], fast);
+        chrono::duration<double> fastFormat = chrono::steady_clock::now() - t0;
+
+        // strftime needs a 'struct tm' for every date
+        string slow;
+        slow.reserve(lines * 11);
+        char line[32];
+        t0 = chrono::steady_clock::now();
+        for (const Date& d : dates) {
+            tm t = {};
+            t.tm_mday = d.getDay();
+            t.tm_mon = d.getMonth() - 1;
+            t.tm_year = d.getYear() - 1900;
+            size_t n = strftime(line, sizeof(line), patterns[f], &t);
+            slow.append(line, n);
+            slow += '\n';
+        }
+        chrono::duration<double> slowFormat = chrono::steady_clock::now() - t0;
+
+        // Both parsers read the SAME text (the strftime output, with leading zeros)
+        vector<Date> back;
+        back.reserve(lines);
+        t0 = chrono::steady_clock::now();
+        size_t bad = Date::parseBatch(slow.data(), slow.size(), formats[f], back).size();
+        chrono::duration<double> fastParse = chrono::steady_clock::now() - t0;
+
+        // get_time reads from a stream, one field at a time
+        long long slowSum = 0;
+        istringstream in(slow);
+        t0 = chrono::steady_clock::now();
+        tm t = {};
+        while (in >> get_time(&t, patterns[f])) {
+            slowSum += daysFromCivil(t.tm_year + 1900, t.tm_mon + 1, t.tm_mday);
+        }
+        chrono::duration<double> slowParse = chrono::steady_clock::now() - t0;
+
+        long long fastSum = 0;
+        for (const Date& d : back) fastSum += d.getSerial();
+        bool match = bad == 0 && fastSum == slowSum && (f == 1 || fast == slow);
+
+        double gbFast = fast.size() / 1e9, gbSlow = slow.size() / 1e9;
+        cout << (f == 0 ? "ISO" : "d/m/y") << "\t" << gbFast / fastFormat.count() << "\t\t" << gbSlow / slowFormat.count()
+             << "\t\t" << gbSlow / fastParse.count() << "\t\t" << gbSlow / slowParse.count()
+             << (match ? "" : "\t(results differ!)") << endl;
+    }
+
+
+    // ---------------------------------------------------------
+    // RANGE QUERIES: which records have a date in [from, to]?
+    // ---------------------------------------------------------
+    Date admissions[6] = {Date(10, 12, 2024), Date(7, 3, 2005), Date(14, 8, 2024),
+                          Date(1, 1, 2025), Date(20, 12, 2024), Date(10, 12, 2024)};
+    DateIndex small;
+    small.bulkLoad(admissions, 6);
+    cout << "\nRecords from 1/12/2024 to 31/12/2024:";
+    for (uint32_t record : small.between(Date(1, 12, 2024), Date(31, 12, 2024))) {
+        cout << " #" << record;
+    }
+    cout << endl;
+
+    // 10M records by default; --large uses 100M (needs about 8 GB of RAM,
+    // most of it for the multimap)
+    bool large = argc > 1 && string(argv[1]) == "--large";
+    size_t recordCount = large ? 100000000 : 10000000;
+    vector<Date> recordDates;
+    recordDates.reserve(recordCount);
+    seed = 16;
+    for (size_t i = 0; i < recordCount; i++) {
+        recordDates.push_back(Date::fromSerial(daysFromCivil(1900, 1, 1) + (int)(nextRandom(seed) % 73048)));
+    }
+
+    start = chrono::steady_clock::now();
+    DateIndex index;
+    index.bulkLoad(recordDates.data(), recordCount);
+    chrono::duration<double> indexLoad = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    multimap<Date, uint32_t> byDate;
+    for (size_t i = 0; i < recordCount; i++) {
+        byDate.emplace(recordDates[i], (uint32_t)i);
+    }
+    chrono::duration<double> mapLoad = chrono::steady_clock::now() - start;
+
+    // 1M queries: 'from' is random, the range is 1 to 7 days long
+    const int queries = 1000000;
+    vector<Date> from(queries), to(queries);
+    for (int q = 0; q < queries; q++) {
+        from[q] = Date::fromSerial(daysFromCivil(1900, 1, 1) + (int)(nextRandom(seed) % 73048));
+        to[q] = Date::fromSerial(from[q].getSerial() + (int)(nextRandom(seed) % 7));
+    }
+
+    long long indexBound = 0, mapBound = 0;
+    start = chrono::steady_clock::now();
+    for (int q = 0; q < queries; q++) indexBound += (long long)index.lowerBound(from[q]);
+    chrono::duration<double, nano> indexBoundTime = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    for (int q = 0; q < queries; q++) {
+        auto it = byDate.lower_bound(from[q]);
+        if (it != byDate.end()) mapBound += it->second;
+    }
+    chrono::duration<double, nano> mapBoundTime = chrono::steady_clock::now() - start;
+
+    // Range scans visit hundreds of records each, so fewer of them
+    const int rangeQueries = 10000;
+    long long indexFound = 0, indexSum = 0, mapFound = 0, mapSum = 0;
+    start = chrono::steady_clock::now();
+    for (int q = 0; q < rangeQueries; q++) {
+        DateIndex::Range range = index.between(from[q], to[q]);
+        indexFound += (long long)range.size();
+        for (uint32_t record : range) indexSum += record;
+    }
+    chrono::duration<double, nano> indexRangeTime = chrono::steady_clock::now() - start;
+
+    start = chrono::steady_clock::now();
+    for (int q = 0; q < rangeQueries; q++) {
+        auto last = byDate.upper_bound(to[q]);
+        for (auto it = byDate.lower_bound(from[q]); it != last; ++it) {
+            mapFound++;
+            mapSum += it->second;
+        }
+    }
+    chrono::duration<double, nano> mapRangeTime = chrono::steady_clock::now() - start;
+
+    cout << "\n--- " << recordCount / 1000000 << "M records ---" << endl;
+    cout << "\t\tload (s)\tlower bound (ns)\t1-7 day range (ns)" << endl;
+    cout << "DateIndex\t" << indexLoad.count() << "\t\t" << indexBoundTime.count() / queries
+         << "\t\t\t" << indexRangeTime.count() / rangeQueries << endl;
+    cout << "multimap\t" << mapLoad.count() << "\t\t" << mapBoundTime.count() / queries
+         << "\t\t\t" << mapRangeTime.count() / rangeQueries << endl;
+    cout << "Records found: " << indexFound << " / " << mapFound
+         << (indexFound == mapFound && indexSum == mapSum ? " (same records)" : " (DIFFERENT!)")
+         << "  [checksum " << indexBound + mapBound << "]" << endl;
+
+    return 0;
+}